@@ -0,0 +1,1299 @@
+/**
+ * @brief
+ * @author Johann Fotsing
+ * @date 2024-09-11
+ * @file pert.cpp
+ */
+
+#include <iostream>
+#include <new>
+#include <bench/pert.h>
+
+std::atomic<std::size_t> allocation_count = 0;
+std::atomic<std::size_t> allocated_bytes = 0;
+
+// the replacements are kept out of line, or GCC pairs the inlined std::malloc and std::free with the caller's
+// operator new and operator delete
+[[gnu::noinline]] void* operator new(std::size_t a_size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes.fetch_add(a_size, std::memory_order_relaxed);
+    if (void* p = std::malloc(a_size == 0 ? 1 : a_size))
+        return p;
+    throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+[[gnu::noinline]] void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+[[gnu::noinline]] void* operator new(std::size_t a_size, std::align_val_t an_alignment)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes.fetch_add(a_size, std::memory_order_relaxed);
+    const std::size_t alignment = static_cast<std::size_t>(an_alignment);
+    if (void* p = std::aligned_alloc(alignment, (std::max<std::size_t>(a_size, 1) + alignment - 1) / alignment * alignment))
+        return p;
+    throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void operator delete(void* p, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+[[gnu::noinline]] void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+int main(int argc, char** argv)
+{
+    // pert_cpm_bench [benchmark [size]], or pert_cpm_bench suite [largest size] for the JSON scaling report
+    const std::string benchmark = argc > 1 ? argv[1] : "all";
+    const int size = argc > 2 ? std::atoi(argv[2]) : 0;
+    int status = 0;
+    if (benchmark == "all" or benchmark == "incremental")
+        status |= bench_incremental(400, 100, size > 0 ? size : 1000);
+    if (benchmark == "all" or benchmark == "monte_carlo")
+        status |= bench_monte_carlo(100, 34, size > 0 ? size : 2000);
+    if (benchmark == "all" or benchmark == "load")
+        status |= bench_load(size > 0 ? size : 1000000);
+    if (benchmark == "all" or benchmark == "snapshot")
+        status |= bench_snapshot(size > 0 ? size : 1000000);
+    if (benchmark == "all" or benchmark == "floats")
+        status |= bench_floats(size > 0 ? size : 1000000);
+    if (benchmark == "all" or benchmark == "critical_path")
+        status |= bench_critical_path(size > 0 ? size : 1000000);
+    if (benchmark == "all" or benchmark == "paths")
+        status |= bench_paths(size > 0 ? size : 1000000);
+    if (benchmark == "all" or benchmark == "interning")
+        status |= bench_interning(size > 0 ? size : 1000000);
+    if (benchmark == "all" or benchmark == "arena")
+        status |= bench_arena(size > 0 ? size : 1000000);
+    if (benchmark == "all" or benchmark == "resources")
+        status |= bench_resources(size > 0 ? size : 10000, 50);
+    if (benchmark == "all" or benchmark == "crashing")
+        status |= bench_crashing(size > 0 ? size : 10000);
+    if (benchmark == "all" or benchmark == "portfolio")
+        status |= bench_portfolio(size > 0 ? size : 2000);
+    if (benchmark == "all" or benchmark == "scenarios")
+        status |= bench_scenarios(size > 0 ? size : 10000);
+    if (benchmark == "all" or benchmark == "server")
+        status |= bench_server(size > 0 ? size : 1000000);
+    if (benchmark == "all" or benchmark == "parallel_times")
+        status |= bench_parallel_times(size > 0 ? size : 1000000);
+    if (benchmark == "all" or benchmark == "fixed")
+        status |= bench_fixed(size > 0 ? size : 100000);
+    if (benchmark == "all" or benchmark == "sensitivity")
+        status |= bench_sensitivity(size > 0 ? size : 100000);
+    if (benchmark == "all" or benchmark == "precedence")
+        status |= bench_precedence(size > 0 ? size : 100000);
+    if (benchmark == "suite")
+        status |= bench_suite(size > 0 ? size : 1000000);
+    if (benchmark == "all" or benchmark == "batch")
+    {
+        status |= bench_batch<int>(100, 34, size > 0 ? size : 2000);
+        status |= bench_batch<double>(100, 34, size > 0 ? size : 2000);
+    }
+    return status;
+}
+
+/// @brief Write a network description file
+void write_txt(const Network& a_network, const std::string& a_file_name)
+{
+    std::ofstream output(a_file_name);
+    output << a_network.initial_time() << '\n' << a_network.terminal_time() << '\n';
+    for (const auto& a: a_network.compiled().activities)
+        output << a.trigger_event() << ' ' << a.completion_event() << ' ' << a_network.estimated_duration(a) << '\n';
+}
+
+/// @brief Build a layered network (see layered_segments), adding its activities one by one
+Network layered_network(int layers, int width, int fan_in, unsigned seed)
+{
+    Network a_network;
+    for (const auto& s: layered_segments(layers, width, fan_in, seed))
+        a_network.add_activity(s.first, s.second);
+    a_network.schedule(0, 0);
+    return a_network;
+}
+
+int bench_incremental(int layers, int width, int edits)
+{
+    using clock = std::chrono::steady_clock;
+    Network a_network = layered_network(layers, width, 3, 42);
+    a_network.schedule(0, a_network.earliest_occurence(layers * width + 1));
+    a_network.times();
+    const auto activities = a_network.compiled().activities;
+    std::cout << "* Incremental rescheduling\n----------" << std::endl;
+    std::cout << "Events: " << a_network.compiled().event_count() << std::endl;
+    std::cout << "Activities: " << activities.size() << std::endl;
+    std::cout << "Edits: " << edits << std::endl;
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<std::size_t> pick(0, activities.size() - 1);
+    std::uniform_int_distribution<int> duration(1, 100);
+    std::vector<std::pair<Network::activity, int>> updates;
+    for (int i = 0; i < edits; ++i)
+        updates.emplace_back(activities[pick(rng)], duration(rng));
+
+    // full recomputation after each edit
+    Network full_network = a_network;
+    auto t0 = clock::now();
+    for (const auto& u: updates)
+    {
+        full_network.set_estimated_duration(u.first, u.second);
+        full_network.schedule(full_network.initial_time(), full_network.terminal_time());
+        full_network.times();
+    }
+    const double full_time = std::chrono::duration<double>(clock::now() - t0).count();
+
+    // incremental propagation after each edit
+    Network incremental_network = a_network;
+    incremental_network.track_changes(true);
+    std::size_t changed_events = 0;
+    t0 = clock::now();
+    for (const auto& u: updates)
+    {
+        incremental_network.set_estimated_duration(u.first, u.second);
+        changed_events += incremental_network.changed().events.size();
+        incremental_network.clear_changes();
+    }
+    const double incremental_time = std::chrono::duration<double>(clock::now() - t0).count();
+
+    // insertions and deletions
+    t0 = clock::now();
+    for (int i = 0; i < edits / 10; ++i)
+    {
+        const auto& a = updates[i].first;
+        incremental_network.delete_activity(a);
+        incremental_network.add_activity(a, updates[i].second);
+        full_network.delete_activity(a);
+        full_network.add_activity(a, updates[i].second);
+    }
+    const double topology_time = std::chrono::duration<double>(clock::now() - t0).count();
+
+    const bool match = incremental_network.times().earliest == full_network.times().earliest
+        and incremental_network.times().latest == full_network.times().latest;
+
+    std::cout << "Full recomputation: " << full_time << " s (" << 1e6 * full_time / edits << " us/edit)" << std::endl;
+    std::cout << "Incremental: " << incremental_time << " s (" << 1e6 * incremental_time / edits << " us/edit)" << std::endl;
+    std::cout << "Changed events per edit: " << static_cast<double>(changed_events) / edits << std::endl;
+    std::cout << "Insert/delete pairs (both networks): " << topology_time << " s" << std::endl;
+    std::cout << "Results match: " << match << std::endl;
+    std::cout << std::endl;
+
+    return match ? 0 : 1;
+}
+
+int bench_monte_carlo(int layers, int width, int samples)
+{
+    using clock = std::chrono::steady_clock;
+    Network a_network = layered_network(layers, width, 3, 42);
+    a_network.schedule(0, a_network.earliest_occurence(layers * width + 1));
+    for (const auto& a: a_network.compiled().activities)
+    {
+        const int d = a_network.estimated_duration(a);
+        a_network.set_estimate(a, Network::estimate(d - d / 4, d, d + d / 2));
+    }
+    std::cout << "* Monte Carlo simulation\n----------" << std::endl;
+    std::cout << "Activities: " << a_network.compiled().activity_count() << std::endl;
+    std::cout << "Samples: " << samples << std::endl;
+
+    monte_carlo<int, int> simulation(a_network);
+    monte_carlo<int, int>::options options;
+    options.samples = samples;
+    options.seed = 42;
+    auto t0 = clock::now();
+    const auto result = simulation.run(options);
+    const double time = std::chrono::duration<double>(clock::now() - t0).count();
+
+    // completion times only, on batches of samples
+    options.criticality = false;
+    t0 = clock::now();
+    const auto forward_only = simulation.run(options);
+    const double forward_time = std::chrono::duration<double>(clock::now() - t0).count();
+
+    // same samples on a single thread
+    options.threads = 1;
+    options.criticality = true;
+    const auto single = simulation.run(options);
+    const bool match = single.completion_times == result.completion_times and single.criticality == result.criticality
+        and forward_only.completion_times == result.completion_times;
+
+    std::cout << "Time: " << time << " s (" << samples / time << " samples/s)" << std::endl;
+    std::cout << "Time without criticality: " << forward_time << " s (" << samples / forward_time << " samples/s)" << std::endl;
+    std::cout << "Mean: " << result.mean << ", standard deviation: " << std::sqrt(result.variance) << std::endl;
+    std::cout << "P10/P50/P90: " << result.percentile(10) << " / " << result.percentile(50) << " / " << result.percentile(90) << std::endl;
+    std::cout << "On time probability: " << result.on_time_probability << std::endl;
+    std::cout << "Highest criticality index: " << *std::max_element(result.criticality.cbegin(), result.criticality.cend()) << std::endl;
+    std::cout << "Reproducible across thread counts: " << match << std::endl;
+    std::cout << std::endl;
+
+    return match ? 0 : 1;
+}
+
+template<typename ValueType>
+int bench_batch(int layers, int width, int batches)
+{
+    using clock = std::chrono::steady_clock;
+    using Batch = batch_forward_pass<int, int, 16, ValueType>;
+    const char* names[] = { "scalar", "avx2", "avx512" };
+    Network a_network = layered_network(layers, width, 3, 42);
+    const auto& adjacency = a_network.compiled();
+    std::cout << "* Batched forward pass (" << (std::is_integral_v<ValueType> ? "int" : "double") << ")\n----------" << std::endl;
+    std::cout << "Activities: " << adjacency.activity_count() << std::endl;
+    std::cout << "Samples: " << batches * Batch::lanes << std::endl;
+
+    // perturbed durations, the same in every run
+    Batch reference(a_network, instruction_set::scalar);
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> noise(0, 20);
+    for (std::size_t a = 0; a < adjacency.activity_count(); ++a)
+        for (std::size_t l = 0; l < Batch::lanes; ++l)
+            reference.durations(a)[l] += static_cast<ValueType>(noise(rng)) / ValueType(2);
+
+    // one sample at a time, as the unbatched pass does
+    std::vector<ValueType> durations(adjacency.activity_count()), earliest(adjacency.event_count());
+    auto t0 = clock::now();
+    ValueType checksum = 0;
+    for (int b = 0; b < batches; ++b)
+    {
+        for (std::size_t l = 0; l < Batch::lanes; ++l)
+        {
+            for (std::size_t a = 0; a < adjacency.activity_count(); ++a)
+                durations[a] = reference.durations(a)[l];
+            for (const auto e: adjacency.order)
+            {
+                ValueType t = 0;
+                for (const auto* a = adjacency.in_begin(e); a != adjacency.in_end(e); ++a)
+                    t = std::max(t, earliest[adjacency.triggers[*a]] + durations[*a]);
+                earliest[e] = t;
+            }
+            checksum += earliest[adjacency.terminal.front()];
+        }
+    }
+    const double unbatched_time = std::chrono::duration<double>(clock::now() - t0).count();
+    std::cout << "Unbatched: " << unbatched_time << " s (" << batches * Batch::lanes / unbatched_time << " samples/s)" << std::endl;
+
+    bool match = true;
+    for (const auto set: { instruction_set::scalar, instruction_set::avx2, instruction_set::avx512 })
+    {
+        if (set != instruction_set::scalar and set > Batch::best_instruction_set())
+            continue;
+        Batch batch(a_network, set);
+        for (std::size_t a = 0; a < adjacency.activity_count(); ++a)
+            std::copy_n(reference.durations(a), Batch::lanes, batch.durations(a));
+        ValueType batch_checksum = 0;
+        t0 = clock::now();
+        for (int b = 0; b < batches; ++b)
+        {
+            batch.run();
+            for (std::size_t l = 0; l < Batch::lanes; ++l)
+                batch_checksum += batch.earliest(adjacency.terminal.front())[l];
+        }
+        const double time = std::chrono::duration<double>(clock::now() - t0).count();
+        match = match and batch_checksum == checksum;
+        std::cout << "Batched " << names[static_cast<int>(set)] << ": " << time << " s (" << batches * Batch::lanes / time << " samples/s, x" << unbatched_time / time << ")" << std::endl;
+    }
+    std::cout << "Results match: " << match << std::endl;
+    std::cout << std::endl;
+
+    return match ? 0 : 1;
+}
+
+int bench_load(int activities)
+{
+    using clock = std::chrono::steady_clock;
+    const int width = 1000;
+    Network a_network = layered_network(std::max(2, activities / (3 * width)), width, 3, 42);
+    const std::string file_name = "pert_cpm_bench_load.txt";
+    write_txt(a_network, file_name);
+    std::cout << "* Network loading\n----------" << std::endl;
+    std::cout << "Activities: " << a_network.compiled().activity_count() << std::endl;
+
+    // whole file copied in a string, single thread
+    auto t0 = clock::now();
+    std::ifstream input_file(file_name);
+    std::string file_str((std::istreambuf_iterator<char>(input_file)), std::istreambuf_iterator<char>());
+    input_file.close();
+    Network copied = Network::from_txt(file_str);
+    copied.compiled();
+    const double copy_time = std::chrono::duration<double>(clock::now() - t0).count();
+
+    // memory mapped file, parsed on every thread
+    t0 = clock::now();
+    Network mapped = load_txt<int, int>(file_name);
+    mapped.compiled();
+    const double map_time = std::chrono::duration<double>(clock::now() - t0).count();
+    std::remove(file_name.c_str());
+
+    const bool match = copied.compiled().activities == a_network.compiled().activities
+        and mapped.compiled().activities == a_network.compiled().activities
+        and mapped.compiled().durations == a_network.compiled().durations;
+    std::cout << "Copied, single thread: " << copy_time << " s" << std::endl;
+    std::cout << "Mapped, " << std::thread::hardware_concurrency() << " thread(s): " << map_time << " s (" << a_network.compiled().activity_count() / map_time << " lines/s)" << std::endl;
+    std::cout << "Results match: " << match << std::endl;
+    std::cout << std::endl;
+
+    return match ? 0 : 1;
+}
+
+int bench_snapshot(int activities)
+{
+    using clock = std::chrono::steady_clock;
+    const int width = 1000;
+    Network a_network = layered_network(std::max(2, activities / (3 * width)), width, 3, 42);
+    const std::string text_name = "pert_cpm_bench_snapshot.txt";
+    const std::string snapshot_name = "pert_cpm_bench_snapshot.bin";
+    write_txt(a_network, text_name);
+    snapshot<int, int>::save(a_network, snapshot_name);
+    std::cout << "* Network snapshot\n----------" << std::endl;
+    std::cout << "Activities: " << a_network.compiled().activity_count() << std::endl;
+
+    // text file parsed, compiled and scheduled
+    auto t0 = clock::now();
+    Network parsed = load_txt<int, int>(text_name);
+    parsed.times();
+    const double text_time = std::chrono::duration<double>(clock::now() - t0).count();
+
+    // snapshot mapped and verified, times read from the mapping
+    t0 = clock::now();
+    const snapshot<int, int> mapped(snapshot_name);
+    const int finish = mapped.events()[mapped.event_count() - 1];
+    const int completion = mapped.earliest_occurence(finish);
+    const double snapshot_time = std::chrono::duration<double>(clock::now() - t0).count();
+
+    // stale files are rejected
+    bool rejected = false;
+    try
+    {
+        const snapshot<int, double> wrong_type(snapshot_name);
+    }
+    catch (const std::runtime_error&)
+    {
+        rejected = true;
+    }
+    std::remove(text_name.c_str());
+    std::remove(snapshot_name.c_str());
+
+    Network rebuilt = mapped.to_network();
+    const bool match = completion == parsed.earliest_occurence(finish)
+        and rebuilt.compiled().activities == a_network.compiled().activities
+        and rebuilt.compiled().durations == a_network.compiled().durations
+        and rebuilt.times().latest == a_network.times().latest
+        and rejected;
+    std::cout << "Text, parsed and scheduled: " << text_time << " s" << std::endl;
+    std::cout << "Snapshot, mapped and verified: " << snapshot_time << " s" << std::endl;
+    std::cout << "Results match: " << match << std::endl;
+    std::cout << std::endl;
+
+    return match ? 0 : 1;
+}
+
+int bench_floats(int activities)
+{
+    using clock = std::chrono::steady_clock;
+    const int width = 1000;
+    Network a_network = layered_network(std::max(2, activities / (3 * width)), width, 3, 42);
+    a_network.times();
+    std::cout << "* Activity floats\n----------" << std::endl;
+    std::cout << "Activities: " << a_network.compiled().activity_count() << std::endl;
+
+    // one accessor call per activity and float
+    auto t0 = clock::now();
+    std::vector<int> single;
+    single.reserve(4 * a_network.compiled().activity_count());
+    for (const auto& a: a_network.compiled().activities)
+    {
+        single.push_back(a_network.activity_float(a));
+        single.push_back(a_network.free_float(a));
+        single.push_back(a_network.interfering_float(a));
+        single.push_back(a_network.independent_float(a));
+    }
+    const double single_time = std::chrono::duration<double>(clock::now() - t0).count();
+
+    // bulk report
+    t0 = clock::now();
+    const Network::float_report report = a_network.floats();
+    const double bulk_time = std::chrono::duration<double>(clock::now() - t0).count();
+
+    // report written as CSV
+    const std::string file_name = "pert_cpm_bench_floats.csv";
+    t0 = clock::now();
+    {
+        std::ofstream output(file_name);
+        write_floats(output, a_network);
+    }
+    const double write_time = std::chrono::duration<double>(clock::now() - t0).count();
+    std::remove(file_name.c_str());
+
+    bool match = true;
+    for (std::size_t a = 0; a < a_network.compiled().activity_count(); ++a)
+        match = match and single[4 * a] == report.activity_float[a] and single[4 * a + 1] == report.free_float[a]
+            and single[4 * a + 2] == report.interfering_float[a] and single[4 * a + 3] == report.independent_float[a];
+    std::cout << "Accessors: " << single_time << " s" << std::endl;
+    std::cout << "Bulk report: " << bulk_time << " s" << std::endl;
+    std::cout << "CSV report (with bulk report): " << write_time << " s" << std::endl;
+    std::cout << "Results match: " << match << std::endl;
+    std::cout << std::endl;
+
+    return match ? 0 : 1;
+}
+
+int bench_critical_path(int activities)
+{
+    using clock = std::chrono::steady_clock;
+    const int width = 1000;
+    Network a_network = layered_network(std::max(2, activities / (3 * width)), width, 3, 42);
+    a_network.times();
+    std::cout << "* Critical path\n----------" << std::endl;
+    std::cout << "Activities: " << a_network.compiled().activity_count() << std::endl;
+
+    auto t0 = clock::now();
+    const Network::path critical_path = a_network.find_critical_path();
+    const double path_time = std::chrono::duration<double>(clock::now() - t0).count();
+
+    t0 = clock::now();
+    const std::vector<Network::path> critical_paths = a_network.critical_paths();
+    const double paths_time = std::chrono::duration<double>(clock::now() - t0).count();
+
+    // the chain is connected, starts at an initial event and its length is the completion time
+    const int finish = a_network.compiled().events.back();
+    int length = a_network.initial_time();
+    bool match = not critical_path.empty() and critical_path.front().first.trigger_event() == 0 and critical_path.back().first.completion_event() == finish;
+    for (std::size_t i = 0; i < critical_path.size(); ++i)
+    {
+        length += critical_path[i].second;
+        match = match and (i == 0 or critical_path[i - 1].first.completion_event() == critical_path[i].first.trigger_event());
+    }
+    match = match and length == a_network.earliest_occurence(finish)
+        and std::find(critical_paths.cbegin(), critical_paths.cend(), critical_path) != critical_paths.cend();
+    std::cout << "Critical path: " << critical_path.size() << " activities, " << path_time << " s" << std::endl;
+    std::cout << "Critical paths: " << critical_paths.size() << " chain(s), " << paths_time << " s" << std::endl;
+    std::cout << "Results match: " << match << std::endl;
+    std::cout << std::endl;
+
+    return match ? 0 : 1;
+}
+
+
+int bench_paths(int paths)
+{
+    using clock = std::chrono::steady_clock;
+    const int layers = 16, width = 10;
+    Network a_network = layered_network(layers, width, 3, 42);
+    const int finish = a_network.compiled().events.back();
+    std::cout << "* Paths\n----------" << std::endl;
+    std::cout << "Activities: " << a_network.compiled().activity_count() << std::endl;
+
+    // counted and measured without enumeration
+    auto t0 = clock::now();
+    const Network::path_summary summary = a_network.summarize_paths(0, finish);
+    const double summary_time = std::chrono::duration<double>(clock::now() - t0).count();
+
+    // enumerated lazily, up to the requested number of paths
+    t0 = clock::now();
+    std::uint64_t count = 0;
+    int shortest = std::numeric_limits<int>::max(), longest = 0;
+    for (const Network::path& p: a_network.enumerate_paths(0, finish))
+    {
+        int length = 0;
+        for (const Network::segment& s: p)
+            length += s.second;
+        shortest = std::min(shortest, length);
+        longest = std::max(longest, length);
+        if (++count == static_cast<std::uint64_t>(paths))
+            break;
+    }
+    const double enumeration_time = std::chrono::duration<double>(clock::now() - t0).count();
+
+    const bool complete = count < static_cast<std::uint64_t>(paths);
+    const bool match = complete ? summary.count == count and summary.shortest == shortest and summary.longest == longest : summary.count >= count;
+    std::cout << "Summary: " << summary.count << " paths, lengths " << summary.shortest << " to " << summary.longest << ", " << summary_time << " s" << std::endl;
+    std::cout << "Enumerated: " << count << (complete ? "" : " (stopped)") << " paths, " << enumeration_time << " s (" << count / enumeration_time << " paths/s)" << std::endl;
+    std::cout << "Results match: " << match << std::endl;
+    std::cout << std::endl;
+
+    return match ? 0 : 1;
+}
+
+/// @brief Build a network from segments, measuring heap use and time of the build, of scheduling, and of queries
+template<typename EventIDType>
+std::vector<double> measure_network(const std::vector<typename network<EventIDType, int>::segment>& some_segments, const std::vector<typename network<EventIDType, int>::activity>& some_queries, long& a_checksum)
+{
+    using clock = std::chrono::steady_clock;
+    const std::size_t heap = mallinfo2().uordblks;
+    auto t0 = clock::now();
+    network<EventIDType, int> a_network;
+    a_network.add_activities(some_segments);
+    a_network.schedule(0, 0);
+    const double build_time = std::chrono::duration<double>(clock::now() - t0).count();
+    t0 = clock::now();
+    a_network.times();
+    const double schedule_time = std::chrono::duration<double>(clock::now() - t0).count();
+    const double bytes = static_cast<double>(mallinfo2().uordblks - heap) / some_segments.size();
+    t0 = clock::now();
+    a_checksum = 0;
+    for (const auto& a: some_queries)
+        a_checksum += a_network.estimated_duration(a) + a_network.earliest_occurence(a.trigger_event()) + a_network.latest_occurence(a.completion_event());
+    const double query_time = std::chrono::duration<double>(clock::now() - t0).count() / some_queries.size();
+    return { bytes, build_time, schedule_time, query_time };
+}
+
+int bench_interning(int activities)
+{
+    const int width = 1000;
+    const Network a_network = layered_network(std::max(2, activities / (3 * width)), width, 3, 42);
+    std::cout << "* Event interning\n----------" << std::endl;
+    std::cout << "Activities: " << a_network.compiled().activity_count() << std::endl;
+
+    // the same network labelled with integers and with WBS codes
+    const auto label = [](int e) { return "WBS-" + std::to_string(1000000 + e); };
+    std::vector<network<int, int>::segment> int_segments;
+    std::vector<network<std::string, int>::segment> string_segments;
+    for (std::size_t a = 0; a < a_network.compiled().activity_count(); ++a)
+    {
+        const auto& activity = a_network.compiled().activities[a];
+        int_segments.emplace_back(activity, a_network.compiled().durations[a]);
+        string_segments.emplace_back(network<std::string, int>::activity(label(activity.trigger_event()), label(activity.completion_event())), a_network.compiled().durations[a]);
+    }
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<std::size_t> pick(0, int_segments.size() - 1);
+    std::vector<network<int, int>::activity> int_queries;
+    std::vector<network<std::string, int>::activity> string_queries;
+    for (int q = 0; q < 1000000; ++q)
+    {
+        const std::size_t a = pick(rng);
+        int_queries.push_back(int_segments[a].first);
+        string_queries.push_back(string_segments[a].first);
+    }
+
+    long int_checksum, string_checksum;
+    const std::vector<double> int_measures = measure_network<int>(int_segments, int_queries, int_checksum);
+    const std::vector<double> string_measures = measure_network<std::string>(string_segments, string_queries, string_checksum);
+
+    const bool match = int_checksum == string_checksum;
+    const char* names[] = { "Heap per activity (bytes)", "Build (s)", "Schedule (s)", "Query (s)" };
+    for (int m = 0; m < 4; ++m)
+        std::cout << names[m] << ": int " << int_measures[m] << ", string " << string_measures[m] << " (x" << string_measures[m] / int_measures[m] << ")" << std::endl;
+    std::cout << "Results match: " << match << std::endl;
+    std::cout << std::endl;
+
+    return match ? 0 : 1;
+}
+
+/// @brief Memory resource counting the bytes it passes on to the default resource
+class counting_resource : public std::pmr::memory_resource
+{
+public:
+    std::size_t bytes = 0;
+
+private:
+    void* do_allocate(std::size_t a_size, std::size_t an_alignment) override
+    {
+        bytes += a_size;
+        return std::pmr::get_default_resource()->allocate(a_size, an_alignment);
+    }
+    void do_deallocate(void* p, std::size_t a_size, std::size_t an_alignment) override
+    {
+        std::pmr::get_default_resource()->deallocate(p, a_size, an_alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& a_resource) const noexcept override
+    {
+        return this == &a_resource;
+    }
+};
+
+/// @brief Build, schedule and report on a network within a memory resource
+/// @return the completion time
+int analyse(const std::vector<Network::segment>& some_segments, std::pmr::memory_resource* a_resource)
+{
+    Network a_network(a_resource);
+    a_network.add_activities(some_segments);
+    a_network.schedule(0, 0);
+    const Network::float_report report = a_network.floats();
+    const Network::path critical_path = a_network.find_critical_path();
+    return a_network.earliest_occurence(critical_path.back().first.completion_event()) + report.free_float[0] - report.free_float[0];
+}
+
+int bench_arena(int activities)
+{
+    using clock = std::chrono::steady_clock;
+    const int width = 1000;
+    const int cycles = 3;
+    const Network a_network = layered_network(std::max(2, activities / (3 * width)), width, 3, 42);
+    std::vector<Network::segment> segments;
+    for (std::size_t a = 0; a < a_network.compiled().activity_count(); ++a)
+        segments.emplace_back(a_network.compiled().activities[a], a_network.compiled().durations[a]);
+    std::cout << "* Memory arena\n----------" << std::endl;
+    std::cout << "Activities: " << segments.size() << std::endl;
+
+    // global heap
+    std::size_t allocations = allocation_count;
+    auto t0 = clock::now();
+    int heap_completion = 0;
+    for (int c = 0; c < cycles; ++c)
+        heap_completion = analyse(segments, std::pmr::get_default_resource());
+    const double heap_time = std::chrono::duration<double>(clock::now() - t0).count() / cycles;
+    const std::size_t heap_allocations = (allocation_count - allocations) / cycles;
+
+    // arena sized after a measured analysis, released between analyses
+    counting_resource counter;
+    {
+        std::pmr::monotonic_buffer_resource sizing(&counter);
+        analyse(segments, &sizing);
+    }
+    arena an_arena(counter.bytes + counter.bytes / 8);
+    allocations = allocation_count;
+    t0 = clock::now();
+    int arena_completion = 0;
+    for (int c = 0; c < cycles; ++c)
+    {
+        arena_completion = analyse(segments, &an_arena);
+        an_arena.release();
+    }
+    const double arena_time = std::chrono::duration<double>(clock::now() - t0).count() / cycles;
+    const std::size_t arena_allocations = (allocation_count - allocations) / cycles;
+
+    const bool match = heap_completion == arena_completion and arena_allocations == 0;
+    std::cout << "Global heap: " << heap_time << " s, " << heap_allocations << " allocations per analysis" << std::endl;
+    std::cout << "Arena (" << counter.bytes / (1 << 20) << " MiB): " << arena_time << " s, " << arena_allocations << " allocations per analysis" << std::endl;
+    std::cout << "Results match: " << match << std::endl;
+    std::cout << std::endl;
+
+    return match ? 0 : 1;
+}
+
+/// @brief Peak resident set size of the process, in kilobytes
+long peak_rss_kb()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+/// @brief Time a benchmark phase and write its JSON record: seconds, activities per second and global allocations
+int bench_resources(int activities, int resources)
+{
+    using clock = std::chrono::steady_clock;
+    using Scheduler = resource_scheduler<int, int>;
+    const int width = 50;
+    Network a_network = layered_network(std::max(2, activities / (3 * width)), width, 3, 42);
+    const Network::adjacency& adjacency = a_network.compiled();
+    std::cout << "* Resource constrained scheduling\n----------" << std::endl;
+    std::cout << "Activities: " << adjacency.activity_count() << ", resources: " << resources << std::endl;
+
+    // each activity holds 1 to 3 units of 1 to 3 resources of capacity 4 to 10
+    std::mt19937 rng(42);
+    Scheduler scheduler(a_network);
+    for (int r = 0; r < resources; ++r)
+        scheduler.add_resource("R" + std::to_string(r), std::uniform_int_distribution<int>(4, 10)(rng));
+    for (const auto& a: adjacency.activities)
+        for (int k = std::uniform_int_distribution<int>(1, 3)(rng); k > 0; --k)
+            scheduler.set_demand(a, std::uniform_int_distribution<int>(0, resources - 1)(rng), std::uniform_int_distribution<int>(1, 3)(rng));
+
+    auto t0 = clock::now();
+    const Scheduler::result single = scheduler.schedule(priority_rule::latest_finish, generation_scheme::serial);
+    const double single_time = std::chrono::duration<double>(clock::now() - t0).count();
+
+    Scheduler::options options;
+    options.threads = 1;
+    t0 = clock::now();
+    const Scheduler::result sequential = scheduler.schedule(options);
+    const double sequential_time = std::chrono::duration<double>(clock::now() - t0).count();
+
+    options.threads = 0;
+    t0 = clock::now();
+    const Scheduler::result best = scheduler.schedule(options);
+    const double pool_time = std::chrono::duration<double>(clock::now() - t0).count();
+
+    // precedence: every activity starts after the activities completing at its trigger event
+    bool feasible = true;
+    for (std::size_t a = 0; a < adjacency.activity_count(); ++a)
+        for (const std::size_t* p = adjacency.in_begin(adjacency.triggers[a]); p != adjacency.in_end(adjacency.triggers[a]); ++p)
+            feasible = feasible and best.finishes[*p] <= best.starts[a];
+
+    // resources: usage at every start time stays within capacity
+    std::vector<std::size_t> by_start(adjacency.activity_count());
+    std::iota(by_start.begin(), by_start.end(), 0);
+    std::sort(by_start.begin(), by_start.end(), [&](std::size_t a, std::size_t b) { return best.starts[a] < best.starts[b]; });
+    std::vector<std::vector<std::pair<int, std::size_t>>> running(resources);
+    for (const std::size_t a: by_start)
+    {
+        for (int r = 0; r < resources; ++r)
+        {
+            const Scheduler::quantity units = scheduler.demand(adjacency.activities[a], r);
+            if (units == 0)
+                continue;
+            auto& on = running[r];
+            on.erase(std::remove_if(on.begin(), on.end(), [&](const auto& u) { return best.finishes[u.second] <= best.starts[a]; }), on.end());
+            on.emplace_back(static_cast<int>(units), a);
+            Scheduler::quantity used = 0;
+            for (const auto& u: on)
+                used += u.first;
+            feasible = feasible and used <= scheduler.capacity(r);
+        }
+    }
+
+    std::cout << "Unconstrained completion: " << a_network.earliest_occurence(std::max(2, activities / (3 * width)) * width + 1) << std::endl;
+    std::cout << "LFT serial schedule: " << single_time << " s, completion " << single.completion << std::endl;
+    std::cout << best.evaluated << " schedules, 1 thread: " << sequential_time << " s" << std::endl;
+    std::cout << best.evaluated << " schedules, " << std::thread::hardware_concurrency() << " thread(s): " << pool_time << " s, best completion " << best.completion << std::endl;
+    std::cout << "Results match: " << (feasible and best.completion == sequential.completion and best.completion <= single.completion) << std::endl;
+    std::cout << std::endl;
+
+    return feasible and best.completion == sequential.completion ? 0 : 1;
+}
+
+int bench_crashing(int activities)
+{
+    using clock = std::chrono::steady_clock;
+    const int width = 50;
+    Network a_network = layered_network(std::max(2, activities / (3 * width)), width, 3, 42);
+    std::cout << "* Time-cost trade-off\n----------" << std::endl;
+    std::cout << "Activities: " << a_network.compiled().activity_count() << std::endl;
+
+    // activities can lose up to half their duration, at 1 to 10 per unit
+    std::mt19937 rng(42);
+    const std::vector<Network::activity> all(a_network.compiled().activities.cbegin(), a_network.compiled().activities.cend());
+    for (const auto& a: all)
+        a_network.set_crash(a, Network::crash(a_network.estimated_duration(a) / 2, std::uniform_int_distribution<int>(1, 10)(rng)));
+
+    auto t0 = clock::now();
+    crashing<int, int> solver(a_network);
+    const crashing<int, int>::result curve = solver.solve();
+    const double solve_time = std::chrono::duration<double>(clock::now() - t0).count();
+
+    // the crashed durations, scheduled from scratch, give the curve's last point at the curve's cost
+    Network crashed;
+    double cost = 0.;
+    for (std::size_t a = 0; a < curve.activities.size(); ++a)
+    {
+        crashed.add_activity(curve.activities[a], curve.durations[a]);
+        cost += a_network.get_crash(curve.activities[a])->cost_slope * (a_network.estimated_duration(curve.activities[a]) - curve.durations[a]);
+    }
+    crashed.schedule(0, 0);
+    int completion = 0;
+    for (const auto e: crashed.terminal_events())
+        completion = std::max(completion, crashed.earliest_occurence(e));
+
+    bool match = completion == curve.curve.back().completion and std::abs(cost - curve.curve.back().cost) <= 1e-6 * std::max(1., cost);
+    for (std::size_t i = 1; i < curve.curve.size(); ++i)
+        match = match and curve.curve[i].completion < curve.curve[i - 1].completion and curve.curve[i].cost >= curve.curve[i - 1].cost;
+    std::cout << "Curve: " << curve.curve.size() << " points, from " << curve.curve.front().completion << " to " << curve.curve.back().completion
+              << " at cost " << curve.curve.back().cost << std::endl;
+    std::cout << "Solve: " << solve_time << " s" << std::endl;
+    std::cout << "Results match: " << match << std::endl;
+    std::cout << std::endl;
+
+    return match ? 0 : 1;
+}
+
+int bench_portfolio(int networks)
+{
+    using clock = std::chrono::steady_clock;
+    using Portfolio = portfolio<int, int>;
+    std::cout << "* Portfolio evaluation\n----------" << std::endl;
+
+    // networks of 100 to 2000 activities from every generator
+    std::vector<std::string> files;
+    std::mt19937 rng(42);
+    for (int n = 0; n < networks; ++n)
+    {
+        const int activities = std::uniform_int_distribution<int>(100, 2000)(rng);
+        const unsigned seed = static_cast<unsigned>(n);
+        Segments segments;
+        switch (n % 3)
+        {
+        case 0: segments = layered_segments(std::max(2, activities / 30), 10, 3, seed); break;
+        case 1: segments = series_parallel_segments(activities, seed); break;
+        default: segments = random_sparse_segments(activities, seed); break;
+        }
+        files.push_back("pert_cpm_bench_portfolio_" + std::to_string(n) + ".txt");
+        write_txt(segments, files.back());
+    }
+    std::cout << "Networks: " << networks << std::endl;
+
+    // one network after the other
+    auto t0 = clock::now();
+    std::vector<Portfolio::report> serial(files.size());
+    for (std::size_t i = 0; i < files.size(); ++i)
+    {
+        serial[i].position = i;
+        Portfolio::analyse(load_txt<int, int>(files[i], 1), serial[i]);
+    }
+    const double serial_time = std::chrono::duration<double>(clock::now() - t0).count();
+    std::cout << "Serial: " << serial_time << " s (" << networks / serial_time << " networks/s)" << std::endl;
+
+    bool match = true;
+    const unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned threads = 1; threads <= hardware; threads = threads < hardware ? std::min(hardware, 2 * threads) : hardware + 1)
+    {
+        Portfolio evaluator(threads);
+        std::size_t streamed = 0;
+        t0 = clock::now();
+        std::vector<Portfolio::report> reports(files.size());
+        evaluator.evaluate_files(files, [&](const Portfolio::report& r) { reports[r.position] = r; ++streamed; });
+        const double time = std::chrono::duration<double>(clock::now() - t0).count();
+        for (std::size_t i = 0; i < files.size(); ++i)
+            match = match and reports[i].ok and reports[i].completion == serial[i].completion and reports[i].critical_path == serial[i].critical_path
+                and reports[i].critical_activities == serial[i].critical_activities;
+        match = match and streamed == files.size();
+        std::cout << threads << " thread(s): " << time << " s (" << networks / time << " networks/s, speedup " << serial_time / time << ")" << std::endl;
+    }
+    for (const auto& f: files)
+        std::remove(f.c_str());
+    std::cout << "Results match: " << match << std::endl;
+    std::cout << std::endl;
+
+    return match ? 0 : 1;
+}
+
+int bench_scenarios(int scenarios)
+{
+    using clock = std::chrono::steady_clock;
+    using Scenario = scenario<int, int>;
+    std::cout << "* What-if scenarios\n----------" << std::endl;
+
+    const int width = 100;
+    const auto base = Scenario::share(layered_network(100 / 3, width, 3, 42));
+    const auto& activities = base->compiled().activities;
+    std::cout << "Activities: " << activities.size() << std::endl;
+
+    // a full copy of the network, ready to be analysed
+    std::size_t bytes = allocated_bytes;
+    {
+        Network copy(*base);
+        copy.times();
+        bytes = allocated_bytes - bytes;
+    }
+    std::cout << "Network copy: " << bytes << " bytes" << std::endl;
+
+    // scenarios changing two durations, deleting an activity and adding one towards a new event
+    auto t0 = clock::now();
+    bytes = allocated_bytes;
+    std::vector<Scenario> what_ifs;
+    what_ifs.reserve(scenarios);
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<std::size_t> pick(0, activities.size() - 1);
+    for (int s = 0; s < scenarios; ++s)
+    {
+        Scenario& what_if = what_ifs.emplace_back(base);
+        what_if.set_estimated_duration(activities[pick(rng)], std::uniform_int_distribution<int>(1, 100)(rng));
+        what_if.set_estimated_duration(activities[pick(rng)], std::uniform_int_distribution<int>(1, 100)(rng));
+        what_if.delete_activity(activities[pick(rng)]);
+        what_if.add_activity(Network::activity(activities[pick(rng)].completion_event(), 1000000 + s), std::uniform_int_distribution<int>(1, 1000)(rng));
+    }
+    bytes = allocated_bytes - bytes;
+    const double build_time = std::chrono::duration<double>(clock::now() - t0).count();
+    std::cout << "Scenarios: " << scenarios << ", " << bytes / scenarios << " bytes each (" << build_time << " s)" << std::endl;
+
+    // analyse every scenario concurrently
+    thread_pool pool;
+    std::vector<int> completions(what_ifs.size());
+    t0 = clock::now();
+    pool.parallel_for(what_ifs.size(), [&](std::size_t s) { completions[s] = what_ifs[s].analyse().completion(); });
+    const double analysis_time = std::chrono::duration<double>(clock::now() - t0).count();
+    std::cout << "Analysis: " << analysis_time << " s on " << pool.size() << " thread(s) (" << scenarios / analysis_time << " scenarios/s)" << std::endl;
+
+    // a sample of the scenarios against networks edited the same way
+    bool match = true;
+    for (std::size_t s = 0; s < what_ifs.size(); s += std::max<std::size_t>(1, what_ifs.size() / 20))
+    {
+        const Network edited = what_ifs[s].materialize();
+        const auto times = what_ifs[s].analyse();
+        int completion = edited.initial_time();
+        for (const auto e: edited.terminal_events())
+            completion = std::max(completion, edited.earliest_occurence(e));
+        match = match and completion == completions[s];
+        for (const auto e: edited.compiled().events)
+            match = match and times.earliest_occurence(e) == edited.earliest_occurence(e) and times.latest_occurence(e) == edited.latest_occurence(e);
+        for (const auto& a: edited.compiled().activities)
+            match = match and times.activity_float(a) == edited.activity_float(a) and times.free_float(a) == edited.free_float(a);
+    }
+    std::cout << "Results match: " << match << std::endl;
+    std::cout << std::endl;
+
+    return match ? 0 : 1;
+}
+
+int bench_server(int queries)
+{
+    using clock = std::chrono::steady_clock;
+    std::cout << "* Query server\n----------" << std::endl;
+
+    const int width = 100;
+    const int layers = 100;
+    Network a_network = layered_network(layers, width, 3, 42);
+    const auto& activities = a_network.compiled().activities;
+    std::vector<int> expected;
+
+    // a pipelined batch of event and activity queries
+    std::string requests;
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<std::size_t> pick(0, activities.size() - 1);
+    for (int q = 0; q < queries; ++q)
+    {
+        const auto& a = activities[pick(rng)];
+        if (q % 2 == 0)
+        {
+            requests += "earliest_occurence_of " + std::to_string(a.completion_event()) + "\n";
+            expected.push_back(a_network.earliest_occurence(a.completion_event()));
+        }
+        else
+        {
+            requests += "free_float_of " + std::to_string(a.trigger_event()) + " " + std::to_string(a.completion_event()) + "\n";
+            expected.push_back(a_network.free_float(a));
+        }
+    }
+    std::cout << "Activities: " << activities.size() << std::endl;
+    std::cout << "Queries: " << queries << std::endl;
+
+    server<int, int> query_server(std::move(a_network));
+    std::string responses;
+    const auto t0 = clock::now();
+    std::size_t begin = 0;
+    for (std::size_t end = requests.find('\n'); end != std::string::npos; end = requests.find('\n', begin))
+    {
+        query_server.handle(std::string_view(requests).substr(begin, end - begin), responses);
+        begin = end + 1;
+    }
+    const double time = std::chrono::duration<double>(clock::now() - t0).count();
+    std::cout << "Answers: " << time << " s (" << queries / time << " queries/s, " << responses.size() << " bytes)" << std::endl;
+
+    // answers come back in request order
+    bool match = query_server.served_requests() == static_cast<std::size_t>(queries);
+    std::size_t line = 0;
+    for (std::size_t q = 0; match and q < expected.size(); ++q)
+    {
+        const std::size_t result = responses.find("\"result\": ", line);
+        match = result != std::string::npos and std::atoi(responses.c_str() + result + 10) == expected[q];
+        line = responses.find('\n', line) + 1;
+    }
+    std::cout << "Results match: " << match << std::endl;
+    std::cout << std::endl;
+
+    return match ? 0 : 1;
+}
+
+int bench_parallel_times(int activities)
+{
+    using clock = std::chrono::steady_clock;
+    std::cout << "* Level-synchronous scheduling\n----------" << std::endl;
+
+    // wide levels, and the same network with fractional durations to compare floating point times bit for bit
+    const int layers = 30;
+    const Segments segments = layered_segments(layers, std::max(1, activities / (3 * layers)), 3, 42);
+    Network a_network;
+    network<int, double> fractional;
+    a_network.add_activities(segments);
+    for (const auto& s: segments)
+        fractional.add_activity(s.first.trigger_event(), s.first.completion_event(), s.second / 7.);
+    a_network.schedule(0, 0);
+    fractional.schedule(0., 0.);
+    std::cout << "Activities: " << a_network.compiled().activity_count() << ", levels: " << a_network.compiled().level_count() << std::endl;
+
+    auto t0 = clock::now();
+    const auto sequential = a_network.times();
+    const double sequential_time = std::chrono::duration<double>(clock::now() - t0).count();
+    const auto fractional_sequential = fractional.times();
+    std::cout << "Sequential: " << sequential_time << " s" << std::endl;
+
+    bool match = true;
+    const unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned threads = 1; threads <= hardware; threads = threads < hardware ? std::min(hardware, 2 * threads) : hardware + 1)
+    {
+        a_network.schedule(0, 0);
+        t0 = clock::now();
+        const auto& times = a_network.times(threads);
+        const double time = std::chrono::duration<double>(clock::now() - t0).count();
+        match = match and times.earliest == sequential.earliest and times.latest == sequential.latest;
+
+        fractional.schedule(0., 0.);
+        const auto& fractional_times = fractional.times(threads);
+        match = match and std::memcmp(fractional_times.earliest.data(), fractional_sequential.earliest.data(), fractional_times.earliest.size() * sizeof(double)) == 0
+            and std::memcmp(fractional_times.latest.data(), fractional_sequential.latest.data(), fractional_times.latest.size() * sizeof(double)) == 0;
+        std::cout << threads << " thread(s): " << time << " s (speedup " << sequential_time / time << ")" << std::endl;
+    }
+    std::cout << "Results match: " << match << std::endl;
+    std::cout << std::endl;
+
+    return match ? 0 : 1;
+}
+
+// the dummy network of the command line tests, validated and scheduled by the compiler
+using Template = fixed_network<int, int, 11>;
+constexpr Template dummy_template = Template()
+    .add_activity(1, 2, 2).add_activity(1, 4, 2).add_activity(1, 7, 1).add_activity(2, 3, 4).add_activity(4, 5, 5).add_activity(3, 6, 1)
+    .add_activity(4, 8, 8).add_activity(5, 6, 4).add_activity(7, 8, 3).add_activity(6, 9, 3).add_activity(8, 9, 5).schedule(0, 21);
+static_assert(dummy_template.is_well_formed());
+static_assert(dummy_template.earliest_occurence(9) == 15 and dummy_template.latest_occurence(1) == 6);
+static_assert(dummy_template.find_critical_path().size() == 3 and dummy_template.free_float(Template::activity(4, 8)) == 6);
+
+int bench_fixed(int analyses)
+{
+    using clock = std::chrono::steady_clock;
+    using Fixed = fixed_network<int, int, 512>;
+    std::cout << "* Fixed networks\n----------" << std::endl;
+
+    // fixed networks against networks with the same activities
+    bool match = true;
+    for (unsigned seed = 0; seed < 50; ++seed)
+    {
+        Network reference;
+        Fixed fixed;
+        for (const auto& s: series_parallel_segments(200, seed))
+        {
+            reference.add_activity(s.first, s.second);
+            fixed.add_activity(s.first.trigger_event(), s.first.completion_event(), s.second);
+        }
+        reference.schedule(0, 1000);
+        fixed.schedule(0, 1000);
+        const auto floats = reference.floats();
+        const auto fixed_floats = fixed.floats();
+        for (std::size_t a = 0; a < reference.compiled().activity_count(); ++a)
+        {
+            const auto& activity = reference.compiled().activities[a];
+            match = match and fixed.activity_at(a) == Fixed::activity(activity.trigger_event(), activity.completion_event())
+                and fixed_floats.free_float[a] == floats.free_float[a] and fixed_floats.interfering_float[a] == floats.interfering_float[a]
+                and fixed.earliest_occurence(activity.completion_event()) == reference.earliest_occurence(activity.completion_event());
+        }
+        const auto path = reference.find_critical_path();
+        const auto fixed_path = fixed.find_critical_path();
+        match = match and fixed.is_well_formed() == reference.is_well_formed() and path.size() == fixed_path.size();
+        for (std::size_t i = 0; match and i < path.size(); ++i)
+            match = fixed_path[i].first == Fixed::activity(path[i].first.trigger_event(), path[i].first.completion_event()) and fixed_path[i].second == path[i].second;
+    }
+
+    // a template analysed at run time, against the lookups left by the compiler
+    volatile int sink = 0;
+    auto t0 = clock::now();
+    for (int i = 0; i < analyses; ++i)
+    {
+        Network a_template;
+        a_template.add_activity(1, 2, 2).add_activity(1, 4, 2).add_activity(1, 7, 1).add_activity(2, 3, 4).add_activity(4, 5, 5).add_activity(3, 6, 1)
+            .add_activity(4, 8, 8).add_activity(5, 6, 4).add_activity(7, 8, 3).add_activity(6, 9, 3).add_activity(8, 9, 5).schedule(0, 21);
+        sink = sink + a_template.earliest_occurence(9) + a_template.latest_occurence(1);
+    }
+    const double runtime_time = std::chrono::duration<double>(clock::now() - t0).count();
+    t0 = clock::now();
+    for (int i = 0; i < analyses; ++i)
+        sink = sink + dummy_template.earliest_occurence(9) + dummy_template.latest_occurence(1);
+    const double lookup_time = std::chrono::duration<double>(clock::now() - t0).count();
+    std::cout << "Analyses: " << analyses << std::endl;
+    std::cout << "Network built and scheduled at run time: " << runtime_time << " s" << std::endl;
+    std::cout << "Fixed network scheduled at compile time: " << lookup_time << " s" << std::endl;
+    std::cout << "Results match: " << match << std::endl;
+    std::cout << std::endl;
+
+    return match ? 0 : 1;
+}
+
+int bench_sensitivity(int activities)
+{
+    using clock = std::chrono::steady_clock;
+    std::cout << "* Duration sensitivity\n----------" << std::endl;
+
+    const int width = 100;
+    Network a_network = layered_network(std::max(1, activities / (3 * width)), width, 3, 42);
+    const auto& adjacency = a_network.compiled();
+    a_network.times();
+    std::cout << "Activities: " << adjacency.activity_count() << std::endl;
+
+    auto t0 = clock::now();
+    const auto report = a_network.sensitivity();
+    const double sweep_time = std::chrono::duration<double>(clock::now() - t0).count();
+    std::cout << "Sweep: " << sweep_time << " s" << std::endl;
+
+    // a sample of the activities, rescheduled with durations inside and on both sides of their range
+    const auto completion = [](const Network& some_network)
+    {
+        int _completion = some_network.initial_time();
+        for (const auto e: some_network.terminal_events())
+            _completion = std::max(_completion, some_network.earliest_occurence(e));
+        return _completion;
+    };
+    bool match = completion(a_network) == report.completion;
+    std::size_t reschedules = 0;
+    t0 = clock::now();
+    for (std::size_t a = 0; a < adjacency.activity_count(); a += std::max<std::size_t>(1, adjacency.activity_count() / 50))
+    {
+        const auto activity = adjacency.activities[a];
+        const int original = adjacency.durations[a];
+        for (const int d: { report.lower[a] / 2, report.lower[a], (report.lower[a] + report.upper[a]) / 2, report.upper[a], report.upper[a] + 7 })
+        {
+            Network edited(a_network);
+            edited.set_estimated_duration(activity, d);
+            match = match and completion(edited) == report.completion_with(a, d);
+            ++reschedules;
+        }
+        match = match and a_network.estimated_duration(activity) == original;
+    }
+    const double reschedule_time = std::chrono::duration<double>(clock::now() - t0).count();
+    std::cout << "Reschedules: " << reschedules << " (" << reschedule_time / reschedules * adjacency.activity_count() << " s per activity sweep)" << std::endl;
+    std::cout << "Results match: " << match << std::endl;
+    std::cout << std::endl;
+
+    return match ? 0 : 1;
+}
+
+int bench_precedence(int activities)
+{
+    using clock = std::chrono::steady_clock;
+    std::cout << "* Precedence constraints\n----------" << std::endl;
+
+    const NodeSchedule schedule = node_schedule(activities, 42);
+    std::cout << "Activity-on-node schedule: " << schedule.durations.size() << " activities, " << schedule.relations.size() << " relations" << std::endl;
+
+    // import, compile, schedule and report the floats, with relations as dummy activities or as constraints
+    const auto analyse = [](Network& a_network)
+    {
+        a_network.compiled();
+        a_network.times();
+        return a_network.floats();
+    };
+    std::size_t bytes = allocated_bytes;
+    auto t0 = clock::now();
+    Network dummies;
+    dummies.add_activities(node_segments_with_dummies(schedule));
+    dummies.schedule(0, 0);
+    const auto dummy_floats = analyse(dummies);
+    const double dummy_time = std::chrono::duration<double>(clock::now() - t0).count();
+    const std::size_t dummy_bytes = allocated_bytes - bytes;
+
+    bytes = allocated_bytes;
+    t0 = clock::now();
+    Network constrained = node_network(schedule);
+    const auto floats = analyse(constrained);
+    const double constrained_time = std::chrono::duration<double>(clock::now() - t0).count();
+    const std::size_t constrained_bytes = allocated_bytes - bytes;
+
+    // forward and backward passes alone, rescheduling drops the cached times
+    const int repeats = 10;
+    const auto time_passes = [repeats](Network& a_network)
+    {
+        const auto t0 = clock::now();
+        for (int r = 0; r < repeats; ++r)
+        {
+            a_network.schedule(0, 0);
+            a_network.times();
+        }
+        return std::chrono::duration<double>(clock::now() - t0).count() / repeats;
+    };
+    const double dummy_passes = time_passes(dummies);
+    const double constrained_passes = time_passes(constrained);
+
+    const auto& dummy_adjacency = dummies.compiled();
+    const auto& adjacency = constrained.compiled();
+    std::cout << "Dummy activities: " << dummy_adjacency.event_count() << " events, " << dummy_adjacency.activity_count() << " activities; "
+              << dummy_time << " s, " << dummy_bytes << " bytes; passes " << dummy_passes << " s" << std::endl;
+    std::cout << "Constraints: " << adjacency.event_count() << " events, " << adjacency.activity_count() << " activities and " << adjacency.link_count() << " links ("
+              << adjacency.triggers.size() << " edges); "
+              << constrained_time << " s, " << constrained_bytes << " bytes; passes " << constrained_passes << " s" << std::endl;
+
+    // same event times, and same floats for the activities of the schedule
+    bool match = true;
+    for (std::size_t e = 0; match and e < adjacency.event_count(); ++e)
+    {
+        const auto d = dummy_adjacency.event_index(adjacency.events[e]);
+        match = d != Network::adjacency::npos and dummies.times().earliest[d] == constrained.times().earliest[e]
+            and dummies.times().latest[d] == constrained.times().latest[e];
+    }
+    for (std::size_t a = 0; match and a < adjacency.activity_count(); ++a)
+    {
+        const auto d = dummy_adjacency.activity_index(adjacency.activities[a]);
+        match = dummy_floats.activity_float[d] == floats.activity_float[a] and dummy_floats.free_float[d] == floats.free_float[a]
+            and dummy_floats.interfering_float[d] == floats.interfering_float[a];
+    }
+
+    // a constraint sharing the link of a relation: deleting either constraint keeps the other one's lag
+    const Relation& shared = *std::find_if(schedule.relations.cbegin(), schedule.relations.cend(), [](const Relation& r) { return r.relation == pert::precedence::finish_to_start; });
+    const Network::activity other(-1, node_activity(shared.predecessor).completion_event());
+    const Network::activity shared_link(node_activity(shared.predecessor).completion_event(), node_activity(shared.successor).trigger_event());
+    Network edited = constrained;
+    edited.add_constraint(other, node_activity(shared.successor), pert::precedence::finish_to_start, shared.lag + 5);
+    edited.delete_constraint(node_activity(shared.predecessor), node_activity(shared.successor));
+    match = match and edited.links().at(shared_link) == shared.lag + 5
+        and edited.earliest_occurence(shared_link.completion_event()) >= edited.earliest_occurence(shared_link.trigger_event()) + shared.lag + 5;
+    edited.add_constraint(node_activity(shared.predecessor), node_activity(shared.successor), pert::precedence::finish_to_start, shared.lag);
+    edited.delete_constraint(other, node_activity(shared.successor));
+    match = match and edited.links().at(shared_link) == shared.lag and edited.times().earliest == constrained.times().earliest
+        and edited.times().latest == constrained.times().latest;
+    std::cout << "Results match: " << match << std::endl;
+    std::cout << std::endl;
+
+    return match ? 0 : 1;
+}
+
+template<typename Phase>
+void time_phase(std::ostream& an_output, const char* a_name, std::size_t activities, Phase a_phase, bool last = false)
+{
+    const std::size_t allocations = allocation_count;
+    const auto t0 = std::chrono::steady_clock::now();
+    a_phase();
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    an_output << "        \"" << a_name << "\": { \"seconds\": " << seconds << ", \"activities_per_second\": " << (seconds > 0 ? activities / seconds : 0)
+              << ", \"allocations\": " << allocation_count - allocations << " }" << (last ? "" : ",") << "\n";
+}
+
+int bench_suite(int largest)
+{
+    using generator = Segments (*)(int, unsigned);
+    const std::vector<std::pair<const char*, generator>> generators {
+        { "layered", [](int activities, unsigned seed)
+            {
+                const int width = std::max(1, static_cast<int>(std::sqrt(activities / 3.0)));
+                return layered_segments(std::max(2, activities / (3 * width)), width, 3, seed);
+            } },
+        { "series_parallel", series_parallel_segments },
+        { "random_sparse", random_sparse_segments },
+        { "chain", chain_segments }
+    };
+    const std::string file_name = "pert_cpm_bench_suite.txt";
+    bool first = true;
+    int status = 0;
+
+    std::cout.precision(6);
+    std::cout << "{\n  \"version\": \"" << pert_cpm_VERSION_MAJOR << "." << pert_cpm_VERSION_MINOR << "\",\n  \"benchmarks\": [\n";
+    for (const auto& [name, generate]: generators)
+    {
+        for (long size = 100; size <= largest; size *= 10)
+        {
+            const Segments segments = generate(static_cast<int>(size), 42);
+            write_txt(segments, file_name);
+            std::cout << (first ? "" : ",\n") << "    {\n      \"generator\": \"" << name << "\",\n      \"activities\": " << segments.size() << ",\n      \"phases\": {\n";
+            first = false;
+
+            Network parsed, built;
+            std::size_t critical = 0;
+            time_phase(std::cout, "parse", segments.size(), [&]() { parsed = load_txt<int, int>(file_name); });
+            time_phase(std::cout, "construction", segments.size(), [&]() { built.add_activities(segments); built.compiled(); });
+            time_phase(std::cout, "is_well_formed", segments.size(), [&]() { status |= built.is_well_formed() ? 0 : 1; });
+            time_phase(std::cout, "forward_backward", segments.size(), [&]() { built.times(); });
+            time_phase(std::cout, "floats", segments.size(), [&]() { built.floats(); });
+            time_phase(std::cout, "critical_path", segments.size(), [&]() { critical = built.find_critical_path().size(); });
+
+            // a subnet around the middle of the critical path
+            const Network::path critical_path = built.find_critical_path();
+            const auto& middle = critical_path[critical_path.size() / 2].first;
+            const int subnet_finish = critical_path[std::min(critical_path.size() - 1, critical_path.size() / 2 + 2)].first.completion_event();
+            std::size_t subnet_activities = 0;
+            time_phase(std::cout, "subnet", segments.size(), [&]() { subnet_activities = built.subnet(middle.trigger_event(), subnet_finish).activity_count(); }, true);
+
+            std::cout << "      },\n      \"events\": " << built.compiled().event_count() << ",\n      \"critical_activities\": " << critical
+                      << ",\n      \"subnet_activities\": " << subnet_activities << ",\n      \"peak_rss_kb\": " << peak_rss_kb() << "\n    }";
+            status |= parsed.compiled().activity_count() == built.compiled().activity_count() ? 0 : 1;
+        }
+    }
+    std::cout << "\n  ]\n}" << std::endl;
+    std::remove(file_name.c_str());
+
+    return status;
+}
@@ -0,0 +1,234 @@
+/***
+ * @brief This file describes seeded generators of synthetic networks for benchmarks.
+ * @author Johann Fotsing
+ * @date 2026-10-16
+ * @file generators.h
+ */
+
+#pragma once
+
+#include <pert.h>
+#include <fstream>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+using Network = pert::network<int, int>;
+using Segments = std::vector<Network::segment>;
+
+/// @brief Build a layered network: a start event, layers of events, and a finish event.
+///        Each event of a layer is triggered by some events of the previous layer.
+///        The start event is 0 and the finish event is layers * width + 1.
+inline Segments layered_segments(int layers, int width, int fan_in, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> duration(1, 100);
+    std::uniform_int_distribution<int> column(0, width - 1);
+    Segments segments;
+    segments.reserve(static_cast<std::size_t>(layers) * width * fan_in + 2 * width);
+
+    const int start = 0;
+    const int finish = layers * width + 1;
+    auto event = [width](int layer, int c) { return 1 + layer * width + c; };
+    for (int c = 0; c < width; ++c)
+    {
+        segments.emplace_back(Network::activity(start, event(0, c)), duration(rng));
+        segments.emplace_back(Network::activity(event(layers - 1, c), finish), duration(rng));
+    }
+    for (int l = 1; l < layers; ++l)
+    {
+        for (int c = 0; c < width; ++c)
+        {
+            segments.emplace_back(Network::activity(event(l - 1, c), event(l, c)), duration(rng));
+            for (int k = 1; k < fan_in; ++k)
+            {
+                const int from = column(rng);
+                segments.emplace_back(Network::activity(event(l - 1, from), event(l, c)), duration(rng));
+            }
+        }
+    }
+    return segments;
+}
+
+/// @brief Build a series-parallel network from the activity 0 -> 1.
+///        Each step picks an activity (u, v) and either splits it in series, (u, w) then (w, v),
+///        or doubles it with a parallel branch (u, w) then (w, v) through a new event w.
+inline Segments series_parallel_segments(int activities, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> duration(1, 100);
+    std::bernoulli_distribution series(0.5);
+    std::vector<std::pair<int, int>> edges { { 0, 1 } };
+    edges.reserve(activities + 1);
+    int events = 2;
+    while (static_cast<int>(edges.size()) < activities)
+    {
+        const std::size_t e = std::uniform_int_distribution<std::size_t>(0, edges.size() - 1)(rng);
+        const auto [u, v] = edges[e];
+        const int w = events++;
+        if (series(rng))
+            edges[e] = { u, w };
+        else
+            edges.push_back({ u, w });
+        edges.push_back({ w, v });
+    }
+    Segments segments;
+    segments.reserve(edges.size());
+    for (const auto& [u, v]: edges)
+        segments.emplace_back(Network::activity(u, v), duration(rng));
+    return segments;
+}
+
+/// @brief Build a random sparse network: activities join random events to later events,
+///        then a start event 0 triggers every event without predecessor and every event without
+///        successor triggers a finish event.
+inline Segments random_sparse_segments(int activities, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> duration(1, 100);
+    const int events = std::max(3, activities / 4);
+    std::uniform_int_distribution<int> from(1, events - 1);
+    std::geometric_distribution<int> hop(0.05);
+    std::unordered_set<long long> seen;
+    std::vector<char> has_in(events + 1, 0), has_out(events + 1, 0);
+    Segments segments;
+    segments.reserve(activities);
+    for (int attempts = 0; static_cast<int>(segments.size()) < activities - events / 2 and attempts < 4 * activities; ++attempts)
+    {
+        const int u = from(rng);
+        const int v = u + 1 + hop(rng);
+        if (v >= events or not seen.insert(static_cast<long long>(u) * events + v).second)
+            continue;
+        segments.emplace_back(Network::activity(u, v), duration(rng));
+        has_out[u] = has_in[v] = 1;
+    }
+    for (int e = 1; e < events; ++e)
+    {
+        if (not has_in[e])
+            segments.emplace_back(Network::activity(0, e), duration(rng));
+        if (not has_out[e])
+            segments.emplace_back(Network::activity(e, events), duration(rng));
+    }
+    return segments;
+}
+
+/// @brief Build a chain of activities 0 -> 1 -> ... -> activities
+inline Segments chain_segments(int activities, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> duration(1, 100);
+    Segments segments;
+    segments.reserve(activities);
+    for (int e = 0; e < activities; ++e)
+        segments.emplace_back(Network::activity(e, e + 1), duration(rng));
+    return segments;
+}
+
+/// @brief Precedence relation of an activity-on-node schedule
+struct Relation
+{
+    int predecessor;
+    int successor;
+    pert::precedence relation;
+    int lag;
+};
+
+/// @brief Activity-on-node schedule, as exported by scheduling tools: activity durations and the relations between activities
+struct NodeSchedule
+{
+    std::vector<int> durations;
+    std::vector<Relation> relations;
+};
+
+/// @brief Build an activity-on-node schedule: each activity has up to four predecessors among the 200 activities
+///        before it, related finish to start without lag most of the time. No two relations link the same activities.
+inline NodeSchedule node_schedule(int activities, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> duration(1, 100);
+    std::uniform_int_distribution<int> predecessors(1, 4);
+    std::uniform_int_distribution<int> percent(0, 99);
+    std::uniform_int_distribution<int> lag(1, 10);
+    NodeSchedule schedule;
+    schedule.durations.reserve(activities);
+    schedule.relations.reserve(static_cast<std::size_t>(activities) * 5 / 2);
+    for (int j = 0; j < activities; ++j)
+    {
+        schedule.durations.push_back(duration(rng));
+        std::unordered_set<int> chosen;
+        for (int k = j > 0 ? predecessors(rng) : 0; k > 0; --k)
+        {
+            const int i = j - 1 - std::uniform_int_distribution<int>(0, std::min(j, 200) - 1)(rng);
+            if (not chosen.insert(i).second)
+                continue;
+            const int p = percent(rng);
+            const pert::precedence relation = p < 70 ? pert::precedence::finish_to_start : p < 85 ? pert::precedence::start_to_start
+                                            : p < 95 ? pert::precedence::finish_to_finish : pert::precedence::start_to_finish;
+            schedule.relations.push_back({ i, j, relation, percent(rng) < 80 ? 0 : lag(rng) });
+        }
+    }
+    return schedule;
+}
+
+/// @brief Activity of an activity-on-node schedule in an event network: activity i links events 2i and 2i + 1
+inline Network::activity node_activity(int i)
+{
+    return Network::activity(2 * i, 2 * i + 1);
+}
+
+/// @brief Import an activity-on-node schedule the way networks without constraints must: each relation becomes a
+///        dummy activity from the bound end of the predecessor to the successor's trigger event, its lag as duration
+///        (minus the successor's duration for finish to finish and start to finish). Where only dummies of negative
+///        duration reach an event, a dummy from a start event (-1) or to a finish event (-2) keeps it within the schedule.
+inline Segments node_segments_with_dummies(const NodeSchedule& a_schedule)
+{
+    const int activities = static_cast<int>(a_schedule.durations.size());
+    Segments segments;
+    segments.reserve(a_schedule.durations.size() + a_schedule.relations.size());
+    for (int i = 0; i < activities; ++i)
+        segments.emplace_back(node_activity(i), a_schedule.durations[i]);
+    std::vector<char> starts(activities, 0), finishes(activities, 0);  // 1: only negative dummies, 2: one at least not negative
+    for (const Relation& r: a_schedule.relations)
+    {
+        const bool from_finish = r.relation == pert::precedence::finish_to_start or r.relation == pert::precedence::finish_to_finish;
+        const bool to_start = r.relation == pert::precedence::finish_to_start or r.relation == pert::precedence::start_to_start;
+        const int lag = to_start ? r.lag : r.lag - a_schedule.durations[r.successor];
+        segments.emplace_back(Network::activity(2 * r.predecessor + (from_finish ? 1 : 0), 2 * r.successor), lag);
+        starts[r.successor] = std::max<char>(starts[r.successor], lag < 0 ? 1 : 2);
+        if (from_finish)
+            finishes[r.predecessor] = std::max<char>(finishes[r.predecessor], lag < 0 ? 1 : 2);
+    }
+    for (int i = 0; i < activities; ++i)
+    {
+        if (starts[i] == 1)
+            segments.emplace_back(Network::activity(-1, 2 * i), 0);
+        if (finishes[i] == 1)
+            segments.emplace_back(Network::activity(2 * i + 1, -2), 0);
+    }
+    return segments;
+}
+
+/// @brief Import an activity-on-node schedule with its relations as precedence constraints, scheduled from 0 to 0
+inline Network node_network(const NodeSchedule& a_schedule)
+{
+    Segments segments;
+    segments.reserve(a_schedule.durations.size());
+    for (int i = 0; i < static_cast<int>(a_schedule.durations.size()); ++i)
+        segments.emplace_back(node_activity(i), a_schedule.durations[i]);
+    Network a_network;
+    a_network.add_activities(segments);
+    for (const Relation& r: a_schedule.relations)
+        a_network.add_constraint(node_activity(r.predecessor), node_activity(r.successor), r.relation, r.lag);
+    a_network.schedule(0, 0);
+    return a_network;
+}
+
+/// @brief Write a network description file from activity segments
+inline void write_txt(const Segments& some_segments, const std::string& a_file_name)
+{
+    std::ofstream output(a_file_name);
+    output << 0 << '\n' << 0 << '\n';
+    for (const auto& s: some_segments)
+        output << s.first.trigger_event() << ' ' << s.first.completion_event() << ' ' << s.second << '\n';
+}
@@ -0,0 +1,58 @@
+/***
+ * @brief
+ * @author Johann Fotsing
+ * @date 2024-09-11
+ * @file pert.h
+ */
+
+#include <atomic>
+#include <iostream>
+#include <pert.h>
+#include <pert_monte_carlo.h>
+#include <pert_batch.h>
+#include <pert_io.h>
+#include <pert_resources.h>
+#include <pert_crashing.h>
+#include <pert_portfolio.h>
+#include <pert_scenario.h>
+#include <pert_server.h>
+#include <pert_constexpr.h>
+#include <bench/generators.h>
+#include <pert_cpm_config.h>
+#include <cstring>
+#include <fstream>
+#include <chrono>
+#include <random>
+#include <malloc.h>
+#include <sys/resource.h>
+
+using namespace pert;
+
+
+// Benchmark functions
+Network layered_network(int, int, int, unsigned);
+void write_txt(const Network&, const std::string&);
+int bench_incremental(int, int, int);
+int bench_monte_carlo(int, int, int);
+int bench_load(int);
+int bench_snapshot(int);
+int bench_floats(int);
+int bench_critical_path(int);
+int bench_paths(int);
+int bench_interning(int);
+int bench_arena(int);
+int bench_suite(int);
+int bench_resources(int, int);
+int bench_crashing(int);
+int bench_portfolio(int);
+int bench_scenarios(int);
+int bench_server(int);
+int bench_parallel_times(int);
+int bench_fixed(int);
+int bench_sensitivity(int);
+int bench_precedence(int);
+
+// Global allocation counter, also bumped by the thread pool workers
+extern std::atomic<std::size_t> allocation_count;
+extern std::atomic<std::size_t> allocated_bytes;
+template<typename ValueType> int bench_batch(int, int, int);
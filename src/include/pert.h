@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <pert_thread_pool.h>
 #include <map>
 #include <set>
 #include <algorithm>
@@ -14,8 +15,23 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <optional>
+#include <memory_resource>
+#include <stdexcept>
+#include <string_view>
+#include <charconv>
+#include <thread>
+#include <atomic>
+#include <chrono>
 #include <bits/stdc++.h>
 
+/// @brief Instrumentation statements, compiled only when PERT_CPM_STATS is defined
+#ifdef PERT_CPM_STATS
+#define PERT_STATS(...) __VA_ARGS__
+#else
+#define PERT_STATS(...)
+#endif
+
 /**
  * @brief PERT classes and methods are in namespace pert
  * 
@@ -23,6 +39,449 @@
 namespace pert
 {
 
+    /**
+     * @brief Operation counters and phase timers of every network, updated when the library is built with PERT_CPM_STATS.
+     * Otherwise instrumentation compiles to nothing and the statistics stay at zero.
+     * Every statistic is a relaxed atomic counter, so networks may be analysed on several threads at once (portfolios,
+     * chunked parsing); statistics read while analyses run may miss their latest updates.
+     *
+     */
+    struct statistics
+    {
+        /// @brief Statistic updated with relaxed atomic operations
+        class counter
+        {
+
+        public:
+            counter(std::uint64_t a_value = 0) : __value(a_value) {}
+            counter(const counter& a_counter) : __value(std::uint64_t(a_counter)) {}
+            counter& operator=(const counter& a_counter) { __value.store(std::uint64_t(a_counter), std::memory_order_relaxed); return *this; }
+            counter& operator++() { __value.fetch_add(1, std::memory_order_relaxed); return *this; }
+            counter& operator+=(std::uint64_t an_amount) { __value.fetch_add(an_amount, std::memory_order_relaxed); return *this; }
+            operator std::uint64_t() const { return __value.load(std::memory_order_relaxed); }
+
+        private:
+            std::atomic<std::uint64_t> __value;
+        };
+
+        // operation calls
+        counter parses = 0;
+        counter compilations = 0;
+        counter validations = 0;
+        counter schedules = 0;                      ///< full forward and backward passes
+        counter incremental_updates = 0;            ///< forward or backward propagations after an edit
+        counter occurence_queries = 0;
+        counter float_reports = 0;
+        counter critical_path_searches = 0;
+        counter paths_enumerated = 0;
+
+        // traversals
+        counter events_visited = 0;
+        counter edges_visited = 0;
+
+        // memory of networks built with the default constructor
+        counter allocations = 0;
+        counter allocated_bytes = 0;
+
+        // wall time per phase, in nanoseconds
+        counter parse_ns = 0;
+        counter validate_ns = 0;
+        counter forward_ns = 0;
+        counter backward_ns = 0;
+        counter critical_path_ns = 0;
+
+        /// @brief Check whether the library was built with instrumentation
+        static constexpr bool enabled()
+        {
+#ifdef PERT_CPM_STATS
+            return true;
+#else
+            return false;
+#endif
+        };
+
+        /// @brief Set every statistic back to zero
+        void reset() { *this = statistics(); }
+
+        /// @brief Get the statistics as a JSON object
+        std::string to_json() const
+        {
+            std::ostringstream _json;
+            _json << "{\"enabled\": " << (enabled() ? "true" : "false")
+                  << ", \"calls\": {\"parse\": " << parses << ", \"compile\": " << compilations << ", \"validate\": " << validations
+                  << ", \"schedule\": " << schedules << ", \"incremental_update\": " << incremental_updates << ", \"occurence_query\": " << occurence_queries
+                  << ", \"float_report\": " << float_reports << ", \"critical_path\": " << critical_path_searches << ", \"path\": " << paths_enumerated << "}"
+                  << ", \"visited\": {\"events\": " << events_visited << ", \"edges\": " << edges_visited << "}"
+                  << ", \"memory\": {\"allocations\": " << allocations << ", \"bytes\": " << allocated_bytes << "}"
+                  << ", \"seconds\": {\"parse\": " << parse_ns * 1e-9 << ", \"validate\": " << validate_ns * 1e-9 << ", \"forward\": " << forward_ns * 1e-9
+                  << ", \"backward\": " << backward_ns * 1e-9 << ", \"critical_path\": " << critical_path_ns * 1e-9 << "}}";
+            return _json.str();
+        };
+    };
+
+    /// @brief Get the process wide statistics
+    inline statistics& stats()
+    {
+        static statistics _statistics;
+        return _statistics;
+    }
+
+#ifdef PERT_CPM_STATS
+    /// @brief Adds the lifetime of a scope to a phase timer
+    class phase_timer
+    {
+
+    public:
+        explicit phase_timer(statistics::counter& a_timer) : __timer(a_timer), __start(std::chrono::steady_clock::now()) {}
+        ~phase_timer() { __timer += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - __start).count(); }
+
+    private:
+        statistics::counter& __timer;
+        std::chrono::steady_clock::time_point __start;
+    };
+
+    /// @brief Memory resource counting the allocations it forwards to the default resource
+    class statistics_resource : public std::pmr::memory_resource
+    {
+
+    private:
+        void* do_allocate(std::size_t a_size, std::size_t an_alignment) override
+        {
+            ++stats().allocations;
+            stats().allocated_bytes += a_size;
+            return std::pmr::get_default_resource()->allocate(a_size, an_alignment);
+        };
+
+        void do_deallocate(void* a_pointer, std::size_t a_size, std::size_t an_alignment) override
+        {
+            std::pmr::get_default_resource()->deallocate(a_pointer, a_size, an_alignment);
+        };
+
+        bool do_is_equal(const std::pmr::memory_resource& a_resource) const noexcept override
+        {
+            return this == &a_resource;
+        };
+    };
+#endif
+
+    /// @brief Probability laws of an activity duration between its optimistic and pessimistic estimates
+    enum class distribution
+    {
+        beta_pert,
+        triangular,
+        uniform
+    };
+
+    /// @brief Precedence relations between two activities: which end of the predecessor constrains which end of the successor
+    enum class precedence
+    {
+        finish_to_start,
+        start_to_start,
+        finish_to_finish,
+        start_to_finish
+    };
+
+    /**
+     * @brief Error raised when a network description cannot be parsed.
+     * It lists every malformed line with its number (starting at 1).
+     * 
+     */
+    class parse_error : public std::runtime_error
+    {
+
+    public:
+        /// @brief A malformed line
+        struct line
+        {
+            std::size_t number;
+            std::string text;
+            std::string reason;
+        };
+
+        parse_error(std::vector<line> some_lines) : std::runtime_error(message(some_lines)), __lines(std::move(some_lines)) {}
+
+        /// @brief Get the malformed lines, in file order
+        const std::vector<line>& lines() const { return __lines; }
+
+    private:
+        static std::string message(const std::vector<line>& some_lines)
+        {
+            std::string _message = std::to_string(some_lines.size()) + " malformed line(s)";
+            for (std::size_t i = 0; i < some_lines.size() and i < 5; ++i)
+                _message += "\n  line " + std::to_string(some_lines[i].number) + ": " + some_lines[i].reason + ": " + some_lines[i].text;
+            return _message;
+        }
+
+    private:
+        std::vector<line> __lines;
+    };
+
+    /// @brief Parse a whole token into a value, the way network descriptions are read
+    /// @return false if the token does not exactly hold a value
+    template<typename T>
+    bool parse_token(std::string_view a_token, T& a_value)
+    {
+        if constexpr (std::is_arithmetic_v<T>)
+        {
+            const char* _first = a_token.data();
+            if (not a_token.empty() and a_token.front() == '+')
+                ++_first;
+            const auto [_end, _error] = std::from_chars(_first, a_token.data() + a_token.size(), a_value);
+            return _error == std::errc() and _end == a_token.data() + a_token.size();
+        }
+        else if constexpr (std::is_constructible_v<T, std::string_view>)
+        {
+            a_value = T(a_token);
+            return true;
+        }
+        else
+        {
+            std::istringstream _stream { std::string(a_token) };
+            return static_cast<bool>(_stream >> a_value) and _stream.peek() == std::char_traits<char>::eof();
+        }
+    };
+
+    /// @brief Check whether std::hash is enabled for a type
+    template<typename T, typename = void>
+    struct is_hashable : std::false_type {};
+
+    template<typename T>
+    struct is_hashable<T, std::void_t<decltype(std::hash<T>{}(std::declval<const T&>()))>> : std::true_type {};
+
+    /**
+     * @brief This class interns event objects into dense 32 bit ids, in order of first insertion.
+     * Each distinct event is stored once. Small non negative integral events are found directly by value, other events
+     * through an open addressing hash table of ids (or by comparison if the type has no std::hash).
+     *
+     * @tparam EventIDType type of the event objects
+     */
+    template<typename EventIDType>
+    class event_table
+    {
+
+    public:
+
+        /// @brief context types
+        using event = EventIDType;
+        using id = std::uint32_t;
+        static constexpr id npos = static_cast<id>(-1);
+
+    public:
+
+        /// @brief Construct an empty table
+        /// @param a_resource memory resource of the table
+        explicit event_table(std::pmr::memory_resource* a_resource = std::pmr::get_default_resource()) :
+            __events(a_resource), __direct(a_resource), __slots(a_resource), __ids(make_ids(a_resource))
+        {};
+
+        /// @brief Get the id of an event
+        /// @return the event id, npos if the event was never interned
+        id find(const event& an_event) const
+        {
+            if constexpr (std::is_integral_v<event>)
+            {
+                if (in_direct_range(an_event) and static_cast<std::size_t>(an_event) < __direct.size() and __direct[static_cast<std::size_t>(an_event)] != npos)
+                    return __direct[static_cast<std::size_t>(an_event)];
+            }
+            if constexpr (is_hashable<event>::value)
+            {
+                if (__slots.empty())
+                    return npos;
+                const std::uint64_t _hash = hash(an_event);
+                for (std::size_t i = _hash & (__slots.size() - 1); ; i = (i + 1) & (__slots.size() - 1))
+                {
+                    if (__slots[i].value == npos)
+                        return npos;
+                    if (__slots[i].tag == static_cast<std::uint32_t>(_hash >> 32) and __events[__slots[i].value] == an_event)
+                        return __slots[i].value;
+                }
+            }
+            else
+            {
+                auto search = __ids.find(an_event);
+                return search == __ids.end() ? npos : search->second;
+            }
+        };
+
+        /// @brief Get the id of an event, interning the event if needed
+        id intern(const event& an_event)
+        {
+            const id _id = find(an_event);
+            if (_id != npos)
+                return _id;
+            if (__events.size() == npos)
+                throw std::length_error("too many events");
+            const id _new = static_cast<id>(__events.size());
+            if constexpr (std::is_integral_v<event>)
+            {
+                // dense values go to the direct table, which grows with the number of events
+                if (in_direct_range(an_event) and static_cast<std::size_t>(an_event) < std::max<std::size_t>(1 << 16, 4 * (__events.size() + 1)))
+                {
+                    const std::size_t _value = static_cast<std::size_t>(an_event);
+                    if (_value >= __direct.size())
+                        __direct.resize(std::max(_value + 1, 2 * __direct.size()), npos);
+                    __direct[_value] = _new;
+                    __events.push_back(an_event);
+                    return _new;
+                }
+            }
+            if constexpr (is_hashable<event>::value)
+            {
+                if (2 * (__hashed + 1) > __slots.size())
+                    rehash(std::max<std::size_t>(16, 2 * __slots.size()));
+                place(_new, hash(an_event));
+                ++__hashed;
+            }
+            else
+                __ids.emplace(an_event, _new);
+            __events.push_back(an_event);
+            return _new;
+        };
+
+        /// @brief Get an interned event
+        const event& operator[](id an_id) const { return __events[an_id]; }
+
+        /// @brief Get the number of interned events
+        std::size_t size() const { return __events.size(); }
+
+        /// @brief Reserve room for a number of events
+        void reserve(std::size_t a_count)
+        {
+            __events.reserve(a_count);
+            if constexpr (is_hashable<event>::value)
+            {
+                std::size_t _size = 16;
+                while (_size < 2 * a_count)
+                    _size *= 2;
+                if (_size > __slots.size())
+                    rehash(_size);
+            }
+        };
+
+    private:
+
+        /// @brief A hash table slot: an event id and the high bits of the event's hash
+        struct slot
+        {
+            id value = npos;
+            std::uint32_t tag = 0;
+        };
+
+        using id_map = std::conditional_t<is_hashable<event>::value, std::tuple<>, std::pmr::map<event, id>>;
+
+        static id_map make_ids(std::pmr::memory_resource* a_resource)
+        {
+            if constexpr (is_hashable<event>::value)
+                return id_map();
+            else
+                return id_map(a_resource);
+        };
+
+        static bool in_direct_range(const event& an_event)
+        {
+            if constexpr (std::is_signed_v<event>)
+                return not (an_event < 0);
+            else
+                return true;
+        };
+
+        /// @brief Hash of an event, mixed so that consecutive integers spread over the table
+        static std::uint64_t hash(const event& an_event)
+        {
+            std::uint64_t _hash = static_cast<std::uint64_t>(std::hash<event>{}(an_event)) * 0x9E3779B97F4A7C15ULL;
+            return _hash ^ (_hash >> 29);
+        };
+
+        /// @brief Store an id in the first free slot of its probe sequence
+        void place(id an_id, std::uint64_t a_hash)
+        {
+            std::size_t i = a_hash & (__slots.size() - 1);
+            while (__slots[i].value != npos)
+                i = (i + 1) & (__slots.size() - 1);
+            __slots[i] = slot { an_id, static_cast<std::uint32_t>(a_hash >> 32) };
+        };
+
+        /// @brief Rebuild the hash table with a number of slots (a power of 2)
+        void rehash(std::size_t a_size)
+        {
+            __slots.assign(a_size, slot());
+            for (id i = 0; i < __events.size(); ++i)
+            {
+                if constexpr (std::is_integral_v<event>)
+                {
+                    if (in_direct_range(__events[i]) and static_cast<std::size_t>(__events[i]) < __direct.size() and __direct[static_cast<std::size_t>(__events[i])] == i)
+                        continue;
+                }
+                place(i, hash(__events[i]));
+            }
+        };
+
+    // data members
+    private:
+        std::pmr::vector<event> __events;
+        std::pmr::vector<id> __direct;      ///< event value -> id, for small non negative integral events
+        std::pmr::vector<slot> __slots;     ///< open addressing table of the other ids, at most half full
+        std::size_t __hashed = 0;           ///< number of ids in the hash table
+        id_map __ids;                       ///< event -> id, for events without std::hash
+    };
+
+    /**
+     * @brief Monotonic memory arena for networks: memory is handed out from large blocks and released all at once.
+     * The first block is allocated with the arena, so building and analysing a network that fits in it makes no other
+     * allocation. Blocks requested beyond it come from the upstream resource.
+     *
+     */
+    class arena : public std::pmr::memory_resource
+    {
+
+    public:
+        /// @brief Construct an arena
+        /// @param a_size size of the first block, in bytes
+        /// @param an_upstream resource of the blocks
+        explicit arena(std::size_t a_size, std::pmr::memory_resource* an_upstream = std::pmr::get_default_resource()) :
+            __upstream(an_upstream),
+            __size(std::max<std::size_t>(a_size, 1)),
+            __buffer(an_upstream->allocate(__size, alignof(std::max_align_t))),
+            __resource(__buffer, __size, an_upstream)
+        {};
+
+        arena(const arena&) = delete;
+        arena& operator=(const arena&) = delete;
+
+        ~arena()
+        {
+            __resource.release();
+            __upstream->deallocate(__buffer, __size, alignof(std::max_align_t));
+        };
+
+        /// @brief Release every allocation at once, keeping the first block for reuse.
+        ///        Nothing allocated from the arena may be used afterwards.
+        void release()
+        {
+            __resource.release();
+        };
+
+    private:
+        void* do_allocate(std::size_t a_size, std::size_t an_alignment) override
+        {
+            return __resource.allocate(a_size, an_alignment);
+        };
+
+        void do_deallocate(void*, std::size_t, std::size_t) override {};
+
+        bool do_is_equal(const std::pmr::memory_resource& a_resource) const noexcept override
+        {
+            return this == &a_resource;
+        };
+
+    // data members
+    private:
+        std::pmr::memory_resource* __upstream;
+        std::size_t __size;
+        void* __buffer;
+        std::pmr::monotonic_buffer_resource __resource;
+    };
+
     /**
      * @brief This classes describes a template activity network.
      * A network is made of distinct event objects connected by activity objects of specific durations.
@@ -52,8 +511,8 @@ namespace pert
             activity(event a_trigger_event, event a_completion_event) : __trigger_event(a_trigger_event), __completion_event(a_completion_event) {}
             bool precedes(const event& e) const { return __completion_event == e; }
             bool follows(const event& e) const { return __trigger_event == e; }
-            event trigger_event() const { return __trigger_event; }
-            event completion_event() const { return __completion_event; }
+            const event& trigger_event() const { return __trigger_event; }
+            const event& completion_event() const { return __completion_event; }
             activity reverse() const { return activity(__completion_event, __trigger_event); }
             bool operator<(const activity& a) const
             {
@@ -75,9 +534,36 @@ namespace pert
 
         /// @brief context types
         using segment = std::pair<activity, duration>;
-        using path = std::vector<segment>;
+        using path = std::pmr::vector<segment>;
         // TODO: find a way to guarantee that a path is correctly ordered
 
+        /// @brief Three point estimate of an activity duration and the law its duration follows in simulations
+        struct estimate
+        {
+            duration optimistic;
+            duration most_likely;
+            duration pessimistic;
+            distribution law;
+            estimate(duration an_optimistic, duration a_most_likely, duration a_pessimistic, distribution a_law = distribution::beta_pert) : optimistic(an_optimistic), most_likely(a_most_likely), pessimistic(a_pessimistic), law(a_law) {}
+        };
+
+        /// @brief Crash option of an activity: the shortest duration it can be brought down to, and the cost of each duration unit removed
+        struct crash
+        {
+            duration crash_duration;
+            double cost_slope;
+            crash(duration a_crash_duration, double a_cost_slope) : crash_duration(a_crash_duration), cost_slope(a_cost_slope) {}
+        };
+
+        /// @brief A precedence constraint between two activities (see add_constraint)
+        struct precedence_constraint
+        {
+            activity predecessor;
+            activity successor;
+            precedence relation;
+            duration lag;
+        };
+
         /// @brief A schedule defines an earliest start time and a latest finish time for the network completion.
         struct schedule
         {
@@ -86,540 +572,2869 @@ namespace pert
             schedule(duration an_initial_time, duration a_terminal_time) : initial_time(an_initial_time), terminal_time(a_terminal_time) {}
         };
 
-    public:
-
-        /// @brief return a set made of activities in the network
-        /// @return the set of activities of the network
-        std::set<activity> activities() const
+        /**
+         * @brief Compiled, read-only adjacency snapshot of the network.
+         * Events get dense indices (in event order) and activities are stored in (trigger, completion) order,
+         * so the outgoing activities of an event form a contiguous range of activity indices.
+         * Incoming activities are grouped per completion event in a second array (CSR layout).
+         * Precedence constraints are compiled into links: lagged edges between events, stored after the activities in
+         * the edge arrays (triggers, completions, durations) and grouped with them per event, so the topological order
+         * and the passes walk activities and links in one loop. Links are not activities.
+         * 
+         */
+        struct adjacency
         {
-            std::set<activity> _activities;
-            for (const auto& a: __data)
-                _activities.emplace(a.first);
+            using index = std::size_t;
+            static constexpr index npos = static_cast<index>(-1);
+
+            std::pmr::vector<event> events;         ///< event index -> event id (sorted)
+            std::pmr::vector<activity> activities;  ///< activity index -> activity (sorted)
+            std::pmr::vector<duration> durations;   ///< edge index -> estimated duration of an activity, lag of a link
+            std::pmr::vector<index> triggers;       ///< edge index -> trigger (source) event index
+            std::pmr::vector<index> completions;    ///< edge index -> completion (target) event index
+            std::pmr::vector<index> out_offsets;    ///< event index -> first outgoing activity index (size = events + 1)
+            std::pmr::vector<index> in_offsets;     ///< event index -> first slot in in_edges (size = events + 1)
+            std::pmr::vector<index> in_edges;       ///< incoming edge indices grouped by completion event, activities first
+            std::pmr::vector<index> out_edge_offsets; ///< event index -> first slot in out_edges (empty without link)
+            std::pmr::vector<index> out_edges;      ///< outgoing edge indices grouped by trigger event, activities first (empty without link)
+            std::pmr::vector<index> initial;        ///< indices of events with no incoming edge
+            std::pmr::vector<index> terminal;       ///< indices of events with no outgoing edge
+            std::pmr::vector<index> order;          ///< event indices in topological order (partial if the network has loops)
+            std::pmr::vector<index> rank;           ///< event index -> position in order (npos for events caught in loops)
+            std::pmr::vector<index> levels;         ///< first position in order of each topological level, then order.size()
+            std::pmr::vector<std::uint32_t> ids;    ///< event index -> interned event id
+            std::pmr::vector<index> slots;          ///< interned event id -> event index (npos for events without edge)
+
+            /// @brief Construct an empty snapshot
+            /// @param a_resource memory resource of the snapshot arrays
+            explicit adjacency(std::pmr::memory_resource* a_resource = std::pmr::get_default_resource()) :
+                events(a_resource), activities(a_resource), durations(a_resource), triggers(a_resource), completions(a_resource),
+                out_offsets(a_resource), in_offsets(a_resource), in_edges(a_resource), out_edge_offsets(a_resource), out_edges(a_resource),
+                initial(a_resource), terminal(a_resource), order(a_resource), rank(a_resource), levels(a_resource), ids(a_resource), slots(a_resource)
+            {};
+
+            /// @brief Check whether every event could be ordered, i.e. the network has no loop
+            bool acyclic() const { return order.size() == events.size(); }
+
+            /// @brief Get the number of events in the snapshot
+            std::size_t event_count() const { return events.size(); }
+
+            /// @brief Get the number of activities in the snapshot
+            std::size_t activity_count() const { return activities.size(); }
+
+            /// @brief Get the number of precedence constraint links in the snapshot
+            std::size_t link_count() const { return triggers.size() - activities.size(); }
+
+            /// @brief Check whether an edge is a precedence constraint link rather than an activity
+            bool is_link(index an_edge) const { return an_edge >= activities.size(); }
+
+            /// @brief Get the number of topological levels of the snapshot
+            std::size_t level_count() const { return levels.empty() ? 0 : levels.size() - 1; }
+
+            /// @brief Get the dense index of an event
+            /// @param an_event event id
+            /// @return the event index, npos if the event is not in the network
+            index event_index(const event& an_event) const
+            {
+                auto search = std::lower_bound(events.cbegin(), events.cend(), an_event);
+                if (search == events.cend() or an_event < *search)
+                    return npos;
+                return static_cast<index>(search - events.cbegin());
+            }
 
-            return _activities;
-        };
-        
-        /// @brief Add an activity to the network
-        /// @param a_trigger_event activity's trigger event
-        /// @param a_completion_event activity's completion event
-        /// @param a_duration activity's duration
-        /// @return a reference to this network (for syntactic sugar)
-        network& add_activity(const event& a_trigger_event, const event& a_completion_event, const duration& a_duration)
-        {
-            return add_activity(activity(a_trigger_event, a_completion_event), a_duration);
-        };
-        
-        /// @brief Add an activity to the network
-        /// @param an_activity a reference to an activity object that will be copied into the network
-        /// @param a_duration the activity's duration
-        /// @return a reference to this network (for syntactic sugar)
-        network& add_activity(const activity& an_activity, const duration& a_duration)
-        {
-            // no two activities can directly connect two events
-            auto search = __data.find(an_activity.reverse());
-            if (search != __data.end())
+            /// @brief Get the index of an activity
+            /// @param an_activity activity object value
+            /// @return the activity index, npos if the activity is not in the network
+            index activity_index(const activity& an_activity) const
             {
-                // DEBUG
-                std::cout << "Reverse present: " << an_activity.trigger_event() << " ---> " << an_activity.completion_event() << std::endl;
-                return *this;
+                auto search = std::lower_bound(activities.cbegin(), activities.cend(), an_activity);
+                if (search == activities.cend() or not (*search == an_activity))
+                    return npos;
+                return static_cast<index>(search - activities.cbegin());
             }
 
-            __data.insert({an_activity, a_duration});
+            /// @brief Get the edge index of a precedence constraint link
+            /// @param a_link the link's source and target events
+            /// @return the edge index, npos if the link is not in the network
+            index link_index(const activity& a_link) const
+            {
+                const index _source = event_index(a_link.trigger_event());
+                const index _target = event_index(a_link.completion_event());
+                if (_source == npos or _target == npos or out_edges.empty())
+                    return npos;
+                // the outgoing edge slots of an event end with its links, in edge order
+                const auto _first = out_edges.cbegin() + out_edge_begin(_source) + (out_end(_source) - out_begin(_source));
+                const auto _last = out_edges.cbegin() + out_edge_end(_source);
+                const auto _search = std::lower_bound(_first, _last, _target, [this](index l, index e) { return completions[l] < e; });
+                return _search != _last and completions[*_search] == _target ? *_search : npos;
+            }
 
-            return *this;
+            /// @brief First and past-the-end outgoing activity indices of an event
+            index out_begin(index e) const { return out_offsets[e]; }
+            index out_end(index e) const { return out_offsets[e + 1]; }
+
+            /// @brief First and past-the-end incoming edge slots of an event (see in_edges): activities, then links
+            const index* in_begin(index e) const { return in_edges.data() + in_offsets[e]; }
+            const index* in_end(index e) const { return in_edges.data() + in_offsets[e + 1]; }
+
+            /// @brief First and past-the-end outgoing edge slots of an event: activities, then links.
+            ///        Without link, the slots are the outgoing activity indices themselves.
+            index out_edge_begin(index e) const { return out_edges.empty() ? out_offsets[e] : out_edge_offsets[e]; }
+            index out_edge_end(index e) const { return out_edges.empty() ? out_offsets[e + 1] : out_edge_offsets[e + 1]; }
+
+            /// @brief Get the edge of an outgoing edge slot
+            index out_edge(index k) const { return out_edges.empty() ? k : out_edges[k]; }
         };
-        
-        /// @brief Delete an activity from the network
-        /// @param a_trigger_event the activity's trigger event
-        /// @param a_completion_event the activity's completion event
-        /// @return a reference to this network (for syntactic sugar)
-        network& delete_activity(const event& a_trigger_event, const event& a_completion_event)
+
+        /// @brief Earliest and latest occurence times of every event, by event index of the adjacency snapshot.
+        struct event_times
         {
-            return delete_activity(activity(a_trigger_event, a_completion_event));
+            std::pmr::vector<duration> earliest;
+            std::pmr::vector<duration> latest;
+
+            explicit event_times(std::pmr::memory_resource* a_resource = std::pmr::get_default_resource()) : earliest(a_resource), latest(a_resource) {};
         };
-        
-        /// @brief Delete an activity from the network
-        /// @param an_activity the value of the activity object to remove from network
-        /// @return a reference to this network (for syntactic sugar)
-        network& delete_activity(const activity& an_activity)
+
+        /// @brief Dates and floats of every activity, in columns indexed like compiled().activities
+        struct float_report
         {
-            __data.erase(an_activity);
-            return *this;
+            std::pmr::vector<duration> earliest_start;
+            std::pmr::vector<duration> earliest_finish;
+            std::pmr::vector<duration> latest_start;
+            std::pmr::vector<duration> latest_finish;
+            std::pmr::vector<duration> activity_float;
+            std::pmr::vector<duration> free_float;
+            std::pmr::vector<duration> interfering_float;
+            std::pmr::vector<duration> independent_float;
+
+            explicit float_report(std::pmr::memory_resource* a_resource = std::pmr::get_default_resource()) :
+                earliest_start(a_resource), earliest_finish(a_resource), latest_start(a_resource), latest_finish(a_resource),
+                activity_float(a_resource), free_float(a_resource), interfering_float(a_resource), independent_float(a_resource)
+            {};
         };
-        
-        /// @brief Get the estimated duration of an activity in the network
-        /// @param an_activity the value of the activity which duration is requested
-        /// @return the duration of the activity
-        duration estimated_duration(const activity& an_activity) const
-        {
-            // DEBUG ?
-            // TODO: throw an exception
-            auto search_activity = __data.find(an_activity);
-            if (search_activity == __data.end())
-                return -1;
 
-            return __data.at(an_activity);
+        /// @brief Duration sensitivity of every activity, in columns indexed like compiled().activities.
+        ///        The completion time stays the same while an activity's duration is in the closed range [lower, upper].
+        ///        For a critical activity the range is reduced to its current duration (lower == upper). The critical
+        ///        activities (those on a longest path) stay the same in the range too, except at upper for an activity
+        ///        with float, which becomes critical there.
+        ///        Above upper, every extra duration unit delays the completion by one unit. Below lower, every unit
+        ///        saved advances the completion by one unit, for at most relief units.
+        struct sensitivity_report
+        {
+            duration completion;                    ///< latest earliest occurence of the terminal events
+            std::pmr::vector<duration> total_float; ///< completion minus the longest path through the activity
+            std::pmr::vector<duration> lower;       ///< shortest duration in the range (0 for activities off the critical paths)
+            std::pmr::vector<duration> upper;       ///< longest duration in the range (the current one for critical activities)
+            std::pmr::vector<duration> relief;      ///< largest advance of the completion by shortening the activity
+
+            explicit sensitivity_report(std::pmr::memory_resource* a_resource = std::pmr::get_default_resource()) :
+                completion(), total_float(a_resource), lower(a_resource), upper(a_resource), relief(a_resource)
+            {};
+
+            /// @brief Get the completion time if an activity alone took another duration
+            /// @param an_activity activity index
+            /// @param a_duration duration of the activity
+            duration completion_with(std::size_t an_activity, const duration& a_duration) const
+            {
+                const duration _delay = std::max(duration(0), a_duration - upper[an_activity]);
+                const duration _advance = std::min(std::max(duration(0), lower[an_activity] - a_duration), relief[an_activity]);
+                return completion + _delay - _advance;
+            };
         };
 
-        /// @brief Set the estimated duration of an activity in the network
-        /// @param an_activity the value of the activity which duration is to be set
-        /// @param a_duration the duration of the activity
-        void set_estimated_duration(const activity& an_activity, const duration& a_duration)
+        /// @brief Result of a network validation: its ends and its loops.
+        ///        Each loop is a strongly connected component of events, reported with one witness cycle.
+        struct validation
         {
-            // TODO: throw exception if activity is not present
-            __data[an_activity] = a_duration;
+            std::vector<event> initial_events;
+            std::vector<event> terminal_events;
+            std::vector<std::vector<event>> components;     ///< events of each loop component (sorted)
+            std::vector<path> loops;                        ///< one cycle through each component, starting and ending on its first event
+
+            /// @brief Check the validated network has no loop, exactly one start event and exactly one terminal event
+            bool well_formed() const { return initial_events.size() == 1 and terminal_events.size() == 1 and loops.empty(); }
         };
 
-        /// @brief A network is well formed if it contains no loop, exactly one start event and exactly one terminal event.
-        /// @return true if the network is well formed, false otherwise.
-        bool is_well_formed() const
+        /// @brief Events and activities which scheduled times moved since changes were last cleared (sorted, unique).
+        struct changes
         {
-            // check ends
-            if (initial_events().size() != 1 or terminal_events().size() != 1)
+            std::vector<event> events;
+            std::vector<activity> activities;
+        };
+
+        /// @brief Number of paths between two events and their shortest and longest lengths (both 0 without path).
+        ///        The count saturates at the largest std::uint64_t.
+        struct path_summary
+        {
+            std::uint64_t count;
+            duration shortest;
+            duration longest;
+        };
+
+        /**
+         * @brief Lazy range of the paths between two events.
+         * Paths are enumerated depth first, in the order of paths(), on a single backtracking stack: dereferencing an
+         * iterator gives that stack, valid until the iterator is incremented, so no path is copied or allocated.
+         * The network must outlive the range and must not be modified while it is used.
+         *
+         */
+        class path_range
+        {
+            using index = typename adjacency::index;
+
+        public:
+
+            /// @brief Input iterator over the paths of a range
+            class iterator
+            {
+
+            public:
+                using iterator_category = std::input_iterator_tag;
+                using value_type = path;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const path*;
+                using reference = const path&;
+
+                iterator(path_range* a_range = nullptr) : __range(a_range) {};
+
+                reference operator*() const { return __range->__stack; }
+                pointer operator->() const { return &__range->__stack; }
+
+                iterator& operator++()
+                {
+                    if (not __range->advance())
+                        __range = nullptr;
+                    return *this;
+                };
+
+                bool operator==(const iterator& an_iterator) const { return __range == an_iterator.__range; }
+                bool operator!=(const iterator& an_iterator) const { return __range != an_iterator.__range; }
+
+            private:
+                path_range* __range;
+            };
+
+        public:
+
+            /// @brief Prepare the enumeration of the paths starting with a partial path at a current event and leading to a finish event
+            path_range(const adjacency& an_adjacency, const path& a_partial_path, const event& the_current_event, const event& a_finish_event) :
+                __adjacency(an_adjacency),
+                __finish(an_adjacency.event_index(a_finish_event)),
+                __stack(a_partial_path),
+                __on_stack(an_adjacency.event_count(), false),
+                __reaches(an_adjacency.event_count(), false),
+                __yielded(false)
+            {
+                const index _current = an_adjacency.event_index(the_current_event);
+                if (_current == adjacency::npos or __finish == adjacency::npos)
+                    return;
+                mark_triggers(an_adjacency, __stack, __on_stack);
+
+                // only events leading to the finish event through activities are worth stacking
+                std::vector<index> _queue { __finish };
+                __reaches[__finish] = true;
+                for (std::size_t i = 0; i < _queue.size(); ++i)
+                {
+                    for (const index* a = an_adjacency.in_begin(_queue[i]); a != an_adjacency.in_end(_queue[i]) and not an_adjacency.is_link(*a); ++a)
+                    {
+                        if (not __reaches[an_adjacency.triggers[*a]])
+                        {
+                            __reaches[an_adjacency.triggers[*a]] = true;
+                            _queue.push_back(an_adjacency.triggers[*a]);
+                        }
+                    }
+                }
+                __on_stack[_current] = true;
+                __frames.emplace_back(_current, an_adjacency.out_begin(_current));
+            };
+
+            path_range(const path_range&) = delete;
+            path_range& operator=(const path_range&) = delete;
+
+            /// @brief Start the enumeration, a range can be browsed once
+            iterator begin() { return advance() ? iterator(this) : iterator(); }
+            iterator end() { return iterator(); }
+
+        private:
+
+            /// @brief Move the search to the next path
+            /// @return false once every path was enumerated
+            bool advance()
+            {
+                // the last path's final segment is still stacked
+                if (__yielded)
+                    __stack.pop_back();
+                __yielded = false;
+                while (not __frames.empty())
+                {
+                    auto& [_event, _next] = __frames.back();
+                    if (_next == __adjacency.out_end(_event))
+                    {
+                        // the event's branches are exhausted: unstack the segment leading to it
+                        __on_stack[_event] = false;
+                        __frames.pop_back();
+                        if (not __frames.empty())
+                            __stack.pop_back();
+                        continue;
+                    }
+                    const index a = _next++;
+                    const index _completion = __adjacency.completions[a];
+                    PERT_STATS(++stats().edges_visited;)
+
+                    // next segment creates loop or leads away from the finish event
+                    if (on_loop(_event, _completion) or not __reaches[_completion])
+                        continue;
+
+                    __stack.emplace_back(__adjacency.activities[a], __adjacency.durations[a]);
+                    // next segment leads to finish event
+                    if (_completion == __finish)
+                    {
+                        PERT_STATS(++stats().paths_enumerated;)
+                        __yielded = true;
+                        return true;
+                    }
+                    // next segment stacks on the partial path
+                    PERT_STATS(++stats().events_visited;)
+                    __on_stack[_completion] = true;
+                    __frames.emplace_back(_completion, __adjacency.out_begin(_completion));
+                }
                 return false;
-            
-            // check loops
-            const event initial_event = *initial_events().begin();
-            const event terminal_event = *terminal_events().begin();
-            return loop_paths(initial_event, terminal_event).empty();
+            };
+
+            /// @brief Check whether a segment closes a loop on the stack (a self loop away from the finish event is never followed)
+            bool on_loop(index a_trigger, index a_completion) const
+            {
+                return __on_stack[a_completion] and (a_completion != a_trigger or a_completion != __finish);
+            };
+
+        // data members
+        private:
+            const adjacency& __adjacency;
+            index __finish;
+            path __stack;
+            std::vector<bool> __on_stack;
+            std::vector<bool> __reaches;                        ///< events from which the finish event can be reached
+            std::vector<std::pair<index, index>> __frames;      ///< stacked events with their next outgoing activity
+            bool __yielded;
         };
 
-        /// @brief Get the initial events of the network (single element list for well formed network)
-        ///        An initial event is an event with no predecessor activity.
-        /// @return a set of events (unique by definition)
-        std::set<event> initial_events() const
+        /**
+         * @brief View of the activities in between two events of a network, without copy.
+         * The view is an event mask and an activity mask over the network's compiled snapshot: an activity is in the
+         * view when its trigger is reachable from the start event and its completion reaches the finish event, the two
+         * reachability bitsets being built in O(V+E). The view is scheduled like network::subnet always was: from the
+         * earliest occurence of the start event to the latest occurence of the finish event; its own event times are
+         * computed on first use, over the ranks in between both events. Precedence constraint links are edges of the
+         * view like activities: they take part in the reachability, the passes and the critical paths, and materialize()
+         * copies the constraints of the links in between both events.
+         * The network must outlive the view and must not be modified while it is used.
+         *
+         */
+        class subnet_view
         {
-            std::set<event> _initial_events;
-            auto _trigger_events = trigger_events();
-            auto _completion_events = completion_events();
-            for (const auto& e: _trigger_events)
+            using index = typename adjacency::index;
+            using word = std::uint64_t;
+
+        public:
+
+            /// @brief Mask the activities in between two events
+            /// @throw std::out_of_range if an event is not in the network
+            /// @throw std::logic_error if the network contains a loop
+            subnet_view(const network& a_network, const event& a_start_event, const event& a_finish_event) :
+                __network(a_network),
+                __adjacency(a_network.compiled()),
+                __start(a_network.checked_index(__adjacency, a_start_event)),
+                __finish(a_network.checked_index(__adjacency, a_finish_event)),
+                __initial_time(a_network.earliest_occurence(a_start_event)),
+                __terminal_time(a_network.latest_occurence(a_finish_event)),
+                __times(a_network.get_memory_resource())
+            {
+                const std::size_t _event_words = (__adjacency.event_count() + 63) / 64;
+                std::vector<word> _forward(_event_words, 0), _backward(_event_words, 0);
+                std::vector<index> _stack;
+                const auto reach = [&_stack](std::vector<word>& some_bits, index an_event, const auto& a_step)
+                {
+                    set(some_bits, an_event);
+                    _stack.assign(1, an_event);
+                    while (not _stack.empty())
+                    {
+                        const index e = _stack.back();
+                        _stack.pop_back();
+                        a_step(e, [&](index f)
+                        {
+                            if (not test(some_bits, f))
+                            {
+                                set(some_bits, f);
+                                _stack.push_back(f);
+                            }
+                        });
+                    }
+                };
+                reach(_forward, __start, [this](index e, const auto& a_visit)
+                {
+                    for (index k = __adjacency.out_edge_begin(e); k != __adjacency.out_edge_end(e); ++k)
+                        a_visit(__adjacency.completions[__adjacency.out_edge(k)]);
+                });
+                reach(_backward, __finish, [this](index e, const auto& a_visit)
+                {
+                    for (const index* a = __adjacency.in_begin(e); a != __adjacency.in_end(e); ++a)
+                        a_visit(__adjacency.triggers[*a]);
+                });
+
+                // events on a path from start to finish, and the activities and links in between them
+                __events.resize(_event_words);
+                for (std::size_t w = 0; w < _event_words; ++w)
+                {
+                    __events[w] = __start != __finish ? _forward[w] & _backward[w] : 0;
+                    __event_count += static_cast<std::size_t>(__builtin_popcountll(__events[w]));
+                }
+                __edges.assign((__adjacency.triggers.size() + 63) / 64, 0);
+                for (index a = 0; a < __adjacency.triggers.size(); ++a)
+                    if (test(__events, __adjacency.triggers[a]) and test(__events, __adjacency.completions[a]))
+                    {
+                        set(__edges, a);
+                        ++(__adjacency.is_link(a) ? __link_count : __activity_count);
+                    }
+            };
+
+            /// @brief Get the view's scheduled earliest start time: the earliest occurence of its start event
+            duration initial_time() const { return __initial_time; }
+
+            /// @brief Get the view's scheduled latest finish time: the latest occurence of its finish event
+            duration terminal_time() const { return __terminal_time; }
+
+            /// @brief Get the number of events of the view
+            std::size_t event_count() const { return __event_count; }
+
+            /// @brief Get the number of activities of the view
+            std::size_t activity_count() const { return __activity_count; }
+
+            /// @brief Get the number of precedence constraint links of the view
+            std::size_t link_count() const { return __link_count; }
+
+            /// @brief Check whether an event is in the view
+            bool contains(const event& an_event) const
+            {
+                const index e = __network.locate(__adjacency, an_event);
+                return e != adjacency::npos and test(__events, e);
+            };
+
+            /// @brief Check whether an activity is in the view
+            bool contains(const activity& an_activity) const
+            {
+                const index a = __network.locate_activity(__adjacency, an_activity);
+                return a != adjacency::npos and test(__edges, a);
+            };
+
+            /// @brief Get the activities of the view
+            std::set<activity> activities() const
+            {
+                std::set<activity> _activities;
+                for_each_activity([&](index a) { _activities.emplace_hint(_activities.end(), __adjacency.activities[a]); });
+                return _activities;
+            };
+
+            /// @brief Get the estimated duration of an activity of the view, -1 if the activity is not in the view
+            duration estimated_duration(const activity& an_activity) const
+            {
+                const index a = __network.locate_activity(__adjacency, an_activity);
+                return a != adjacency::npos and test(__edges, a) ? __adjacency.durations[a] : -1;
+            };
+
+            /// @brief Get the initial events of the view: its start event, unless the view is empty
+            std::set<event> initial_events() const
+            {
+                return __event_count > 0 ? std::set<event> { __adjacency.events[__start] } : std::set<event> {};
+            };
+
+            /// @brief Get the terminal events of the view: its finish event, unless the view is empty
+            std::set<event> terminal_events() const
+            {
+                return __event_count > 0 ? std::set<event> { __adjacency.events[__finish] } : std::set<event> {};
+            };
+
+            /// @brief A view is well formed unless it is empty: it starts and finishes on a single event, without loop
+            bool is_well_formed() const
+            {
+                return __event_count > 0;
+            };
+
+            /// @brief Get the earliest occurence of an event of the view
+            /// @throw std::out_of_range if the event is not in the view
+            duration earliest_occurence(const event& an_event) const
+            {
+                return times().earliest[checked_index(an_event)];
+            };
+
+            /// @brief Get the latest occurence of an event of the view
+            /// @throw std::out_of_range if the event is not in the view
+            duration latest_occurence(const event& an_event) const
+            {
+                return times().latest[checked_index(an_event)];
+            };
+
+            /// @brief Get the earliest finish date of an activity of the view
+            duration earliest_finish(const activity& an_activity) const
+            {
+                return earliest_occurence(an_activity.trigger_event()) + estimated_duration(an_activity);
+            };
+
+            /// @brief Get the latest start date of an activity of the view
+            duration latest_start(const activity& an_activity) const
+            {
+                return latest_occurence(an_activity.completion_event()) - estimated_duration(an_activity);
+            };
+
+            /// @brief Get the float of an activity of the view, as network::activity_float
+            duration activity_float(const activity& an_activity) const
+            {
+                return earliest_occurence(an_activity.completion_event()) - earliest_finish(an_activity);
+            };
+
+            /// @brief Get the free float of an activity of the view, as network::free_float
+            duration free_float(const activity& an_activity) const
+            {
+                return latest_occurence(an_activity.completion_event()) - earliest_finish(an_activity);
+            };
+
+            /// @brief Get the interfering float of an activity of the view, as network::interfering_float
+            duration interfering_float(const activity& an_activity) const
+            {
+                return std::max(duration(0), earliest_occurence(an_activity.completion_event()) - latest_occurence(an_activity.trigger_event()) - estimated_duration(an_activity));
+            };
+
+            /// @brief Get the independent float of an activity of the view, as network::independent_float
+            duration independent_float(const activity& an_activity) const
+            {
+                return free_float(an_activity) - activity_float(an_activity);
+            };
+
+            /// @brief Get the dates and floats of every activity of the view, as network::floats
+            /// @return the report columns, indexed like the view's activities in compiled() order
+            float_report floats() const
+            {
+                const event_times& _times = times();
+                float_report _report(__network.get_memory_resource());
+                for (auto* _column: { &_report.earliest_start, &_report.earliest_finish, &_report.latest_start, &_report.latest_finish,
+                                      &_report.activity_float, &_report.free_float, &_report.interfering_float, &_report.independent_float })
+                    _column->reserve(__activity_count);
+                for_each_activity([&](index a)
+                {
+                    const duration _duration = __adjacency.durations[a];
+                    const duration _trigger_earliest = _times.earliest[__adjacency.triggers[a]];
+                    const duration _trigger_latest = _times.latest[__adjacency.triggers[a]];
+                    const duration _completion_earliest = _times.earliest[__adjacency.completions[a]];
+                    const duration _completion_latest = _times.latest[__adjacency.completions[a]];
+                    _report.earliest_start.push_back(_trigger_earliest);
+                    _report.earliest_finish.push_back(_trigger_earliest + _duration);
+                    _report.latest_finish.push_back(_completion_latest);
+                    _report.latest_start.push_back(_completion_latest - _duration);
+                    _report.activity_float.push_back(_completion_earliest - _report.earliest_finish.back());
+                    _report.free_float.push_back(_completion_latest - _report.earliest_finish.back());
+                    _report.interfering_float.push_back(std::max(duration(0), _completion_earliest - _trigger_latest - _duration));
+                    _report.independent_float.push_back(_report.free_float.back() - _report.activity_float.back());
+                });
+                return _report;
+            };
+
+            /// @brief Find a critical path of the view, with the ties of network::find_critical_path
+            /// @return list of activity and link segments ordered by precedence, empty if the view has no activity
+            path find_critical_path() const
             {
-                if (_completion_events.find(e) == _completion_events.end())
-                    _initial_events.emplace(e);
+                path _critical_path(__network.get_memory_resource());
+                if (__event_count == 0)
+                    return _critical_path;
+                const event_times& _times = times();
+                for (index e = __finish; ; )
+                {
+                    const index* _tight = std::find_if(__adjacency.in_begin(e), __adjacency.in_end(e), [&](index a) { return test(__edges, a) and tight(__adjacency, _times, a); });
+                    if (_tight == __adjacency.in_end(e))
+                        break;
+                    _critical_path.push_back(edge_segment(__adjacency, *_tight));
+                    e = __adjacency.triggers[*_tight];
+                }
+                std::reverse(_critical_path.begin(), _critical_path.end());
+                return _critical_path;
+            };
+
+            /// @brief Find every critical path of the view, as network::critical_paths
+            /// @return list of critical paths, each ordered by precedence, sorted
+            std::vector<path> critical_paths() const
+            {
+                std::vector<path> _paths;
+                if (__event_count == 0)
+                    return _paths;
+                const event_times& _times = times();
+                const auto _critical = [&](index a) { return test(__edges, a) and tight(__adjacency, _times, a); };
+                std::vector<std::pair<index, const index*>> _stack { { __finish, __adjacency.in_begin(__finish) } };
+                std::vector<index> _chain;
+                while (not _stack.empty())
+                {
+                    const index e = _stack.back().first;
+                    const index* _next = std::find_if(_stack.back().second, __adjacency.in_end(e), _critical);
+                    if (_stack.back().second == __adjacency.in_begin(e) and _next == __adjacency.in_end(e))
+                    {
+                        // no tight incoming edge, e.g. the start event: the chain is complete
+                        path& _path = _paths.emplace_back();
+                        for (auto it = _chain.crbegin(); it != _chain.crend(); ++it)
+                            _path.push_back(edge_segment(__adjacency, *it));
+                    }
+                    if (_next == __adjacency.in_end(e))
+                    {
+                        _stack.pop_back();
+                        if (not _chain.empty())
+                            _chain.pop_back();
+                        continue;
+                    }
+                    _stack.back().second = _next + 1;
+                    _chain.push_back(*_next);
+                    _stack.emplace_back(__adjacency.triggers[*_next], __adjacency.in_begin(__adjacency.triggers[*_next]));
+                }
+                std::sort(_paths.begin(), _paths.end());
+                return _paths;
+            };
+
+            /// @brief Get the paths between two events of the view.
+            ///        Every path of the network between two events of the view stays in the view, so the network enumerates them.
+            std::vector<path> paths(const event& a_start_event, const event& a_finish_event) const
+            {
+                if (not contains(a_start_event) or not contains(a_finish_event))
+                    return {};
+                return __network.paths(a_start_event, a_finish_event);
+            };
+
+            /// @brief Count the paths between two events of the view and find their shortest and longest lengths (see paths)
+            path_summary summarize_paths(const event& a_start_event, const event& a_finish_event) const
+            {
+                if (not contains(a_start_event) or not contains(a_finish_event))
+                    return path_summary { 0, duration(0), duration(0) };
+                return __network.summarize_paths(a_start_event, a_finish_event);
+            };
+
+            /// @brief Build an owned network with the activities, the precedence constraints and the schedule of the view.
+            ///        The constraints of the view's links are copied; a finish bound whose successor is left out of the view
+            ///        gets the successor's duration taken off its lag, so that its link keeps its lag.
+            network materialize() const
+            {
+                std::vector<segment> _segments;
+                _segments.reserve(__activity_count);
+                for_each_activity([&](index a) { _segments.emplace_back(__adjacency.activities[a], __adjacency.durations[a]); });
+                network _network(__network.get_memory_resource());
+                _network.add_activities(_segments);
+                for (const auto& [_key, c]: __network.__constraints)
+                {
+                    const index l = __network.locate_link(__adjacency, __network.to_activity(_key));
+                    if (l == adjacency::npos or not test(__edges, l))
+                        continue;
+                    const activity _successor = __network.to_activity(c.successor);
+                    const bool _left_out = bounds_finish(c.relation) and __network.__data.count(c.successor) > 0 and not contains(_successor);
+                    _network.add_constraint(__network.to_activity(c.predecessor), _successor, c.relation, _left_out ? __network.link_lag(c) : c.lag);
+                }
+                _network.schedule(__initial_time, __terminal_time);
+                return _network;
+            };
+
+        private:
+
+            static bool test(const std::vector<word>& some_bits, index i) { return (some_bits[i / 64] >> (i % 64)) & 1; }
+            static void set(std::vector<word>& some_bits, index i) { some_bits[i / 64] |= word(1) << (i % 64); }
+
+            /// @brief Call a function on the index of every activity of the view, in compiled() order
+            template<typename Function>
+            void for_each_activity(const Function& a_function) const
+            {
+                for (std::size_t w = 0; w < __edges.size(); ++w)
+                    for (word _bits = __edges[w]; _bits != 0; _bits &= _bits - 1)
+                    {
+                        const index a = static_cast<index>(w * 64 + static_cast<std::size_t>(__builtin_ctzll(_bits)));
+                        if (__adjacency.is_link(a))
+                            return;
+                        a_function(a);
+                    }
+            };
+
+            index checked_index(const event& an_event) const
+            {
+                const index e = __network.locate(__adjacency, an_event);
+                if (e == adjacency::npos or not test(__events, e))
+                    throw std::out_of_range("event is not in the subnet");
+                return e;
+            };
+
+            /// @brief Compute the event times of the view on first use, over the ranks from its start to its finish event
+            const event_times& times() const
+            {
+                if (not __times.earliest.empty() or __event_count == 0)
+                    return __times;
+                __times.earliest.resize(__adjacency.event_count());
+                __times.latest.resize(__adjacency.event_count());
+                const index _first = __adjacency.rank[__start];
+                const index _last = __adjacency.rank[__finish];
+                for (index r = _first; r <= _last; ++r)
+                {
+                    const index e = __adjacency.order[r];
+                    if (not test(__events, e))
+                        continue;
+                    // links come last: met first, they keep the event from moving before the initial time
+                    duration& _earliest = __times.earliest[e];
+                    _earliest = __initial_time;
+                    bool _first_edge = true;
+                    for (const index* a = __adjacency.in_end(e); a-- != __adjacency.in_begin(e); )
+                    {
+                        if (not test(__edges, *a))
+                            continue;
+                        const duration _finish = __times.earliest[__adjacency.triggers[*a]] + __adjacency.durations[*a];
+                        _earliest = _first_edge and not __adjacency.is_link(*a) ? _finish : std::max(_earliest, _finish);
+                        _first_edge = false;
+                    }
+                }
+                for (index r = _last + 1; r-- > _first; )
+                {
+                    const index e = __adjacency.order[r];
+                    if (not test(__events, e))
+                        continue;
+                    duration& _latest = __times.latest[e];
+                    _latest = __terminal_time;
+                    bool _first_edge = true;
+                    for (index k = __adjacency.out_edge_end(e); k-- != __adjacency.out_edge_begin(e); )
+                    {
+                        const index a = __adjacency.out_edge(k);
+                        if (not test(__edges, a))
+                            continue;
+                        const duration _start = __times.latest[__adjacency.completions[a]] - __adjacency.durations[a];
+                        _latest = _first_edge and not __adjacency.is_link(a) ? _start : std::min(_latest, _start);
+                        _first_edge = false;
+                    }
+                }
+                return __times;
+            };
+
+        // data members
+        private:
+            const network& __network;
+            const adjacency& __adjacency;
+            index __start;
+            index __finish;
+            duration __initial_time;
+            duration __terminal_time;
+            std::vector<word> __events;                 ///< events on a path from the start to the finish event
+            std::vector<word> __edges;                  ///< activities and links in between both events
+            std::size_t __event_count = 0;
+            std::size_t __activity_count = 0;
+            std::size_t __link_count = 0;
+            mutable event_times __times;                ///< computed on first use
+        };
+
+    public:
+
+        /// @brief return a set made of activities in the network
+        /// @return the set of activities of the network
+        std::set<activity> activities() const
+        {
+            std::set<activity> _activities;
+            for (const auto& a: __data)
+                _activities.emplace(to_activity(a.first));
+
+            return _activities;
+        };
+        
+        /// @brief Add an activity to the network
+        /// @param a_trigger_event activity's trigger event
+        /// @param a_completion_event activity's completion event
+        /// @param a_duration activity's duration
+        /// @return a reference to this network (for syntactic sugar)
+        network& add_activity(const event& a_trigger_event, const event& a_completion_event, const duration& a_duration)
+        {
+            return add_activity(activity(a_trigger_event, a_completion_event), a_duration);
+        };
+        
+        /// @brief Add an activity to the network
+        /// @param an_activity a reference to an activity object that will be copied into the network
+        /// @param a_duration the activity's duration
+        /// @return a reference to this network (for syntactic sugar)
+        network& add_activity(const activity& an_activity, const duration& a_duration)
+        {
+            // no two activities can directly connect two events
+            auto search = __data.find(find_key(an_activity.reverse()));
+            if (search != __data.end())
+            {
+                // DEBUG
+                std::cerr << "Reverse present: " << an_activity.trigger_event() << " ---> " << an_activity.completion_event() << std::endl;
+                return *this;
             }
-            return _initial_events;
+
+            const std::uint64_t _key = intern_key(an_activity);
+            if (__data.emplace(_key, a_duration).second)
+            {
+                reschedule_topology(an_activity);
+                update_finish_bounds(_key, true);
+            }
+
+            return *this;
+        };
+        
+        /// @brief Add many activities to the network, with the same rules as add_activity applied in list order
+        /// @param some_segments activities and their durations
+        /// @return a reference to this network (for syntactic sugar)
+        network& add_activities(const std::vector<segment>& some_segments)
+        {
+            // activities are inserted one by one into a non empty network
+            if (not __data.empty())
+            {
+                for (const auto& s: some_segments)
+                    add_activity(s.first, s.second);
+                return *this;
+            }
+
+            // activities are interned in list order, the topology is compiled once afterwards
+            __data.reserve(some_segments.size());
+            for (const auto& s: some_segments)
+            {
+                const activity& a = s.first;
+                const std::uint64_t _key = intern_key(a);
+                if (__data.find(_key) != __data.end())
+                    continue;
+                if (__data.find(key(completion_id(_key), trigger_id(_key))) != __data.end())
+                {
+                    // DEBUG
+                    std::cerr << "Reverse present: " << a.trigger_event() << " ---> " << a.completion_event() << std::endl;
+                    continue;
+                }
+                __data.emplace(_key, s.second);
+            }
+            invalidate();
+            return *this;
+        };
+
+        /// @brief Delete an activity from the network
+        /// @param a_trigger_event the activity's trigger event
+        /// @param a_completion_event the activity's completion event
+        /// @return a reference to this network (for syntactic sugar)
+        network& delete_activity(const event& a_trigger_event, const event& a_completion_event)
+        {
+            return delete_activity(activity(a_trigger_event, a_completion_event));
+        };
+        
+        /// @brief Delete an activity from the network
+        /// @param an_activity the value of the activity object to remove from network
+        /// @return a reference to this network (for syntactic sugar)
+        network& delete_activity(const activity& an_activity)
+        {
+            const std::uint64_t _key = find_key(an_activity);
+            if (__data.erase(_key) > 0)
+            {
+                __estimates.erase(_key);
+                __crashes.erase(_key);
+                reschedule_topology(an_activity);
+                update_finish_bounds(_key, true);
+            }
+            return *this;
         };
 
-        /// @brief Get the terminal events of the network (single element list for well formed network)
-        ///        A terminal event is an event with no successor activity.
-        /// @return a set of events (unique by definition)
-        std::set<event> terminal_events() const
-        {
-            std::set<event> _terminal_events;
-            auto _trigger_events = trigger_events();
-            auto _completion_events = completion_events();
-            for (const auto& e: _completion_events)
+        /// @brief Add a precedence constraint between two activities: an end of the successor occurs at least a lag after
+        ///        an end of the predecessor. Every constraint bounds the start of the successor, i.e. its trigger event:
+        ///        finish to start and start to start by the lag, finish to finish and start to finish by the lag minus the
+        ///        successor's duration (the whole lag while the successor is not in the network), so that a finish bound moves
+        ///        the successor rather than stretching it. Lags may be negative, but constraints never move an event before
+        ///        the initial time or after the terminal time. The bound events need not carry activities yet.
+        ///        A constraint is compiled into a link between two events rather than an activity: it takes part in the
+        ///        topological order, the passes and the critical paths (as a segment between its events, with its lag as
+        ///        duration), but not in activities(), the floats or path enumeration. Constraints binding the same two events
+        ///        are kept apart and share one link with the largest of their lags; a link from an event to itself without
+        ///        positive lag is already met and left out. Adding a constraint again sets its lag.
+        /// @param a_predecessor the constraining activity
+        /// @param a_successor the constrained activity
+        /// @param a_relation the ends of both activities bound by the constraint
+        /// @param a_lag the least delay between both ends
+        /// @return a reference to this network (for syntactic sugar)
+        network& add_constraint(const activity& a_predecessor, const activity& a_successor, precedence a_relation = precedence::finish_to_start, const duration& a_lag = duration(0))
+        {
+            const std::uint64_t _predecessor = intern_key(a_predecessor);
+            const std::uint64_t _successor = intern_key(a_successor);
+            const std::uint64_t _key = intern_key(link_of(a_predecessor, a_successor, a_relation));
+            const auto [_first, _last] = __constraints.equal_range(_key);
+            const bool _is_new_link = _first == _last;
+            const auto _search = std::find_if(_first, _last, [&](const auto& c) { return c.second.binds(_predecessor, _successor, a_relation); });
+            if (_search != _last)
+                _search->second.lag = a_lag;
+            else
+            {
+                __constraints.emplace(_key, constraint { _predecessor, _successor, a_relation, a_lag });
+                if (bounds_finish(a_relation))
+                    __finish_bounds.emplace(_successor, _key);
+            }
+            update_link(_key, _is_new_link);
+            return *this;
+        };
+
+        /// @brief Delete a precedence constraint between two activities. Other constraints sharing its link are kept.
+        /// @param a_predecessor the constraining activity
+        /// @param a_successor the constrained activity
+        /// @param a_relation the ends of both activities bound by the constraint
+        /// @return a reference to this network (for syntactic sugar)
+        network& delete_constraint(const activity& a_predecessor, const activity& a_successor, precedence a_relation = precedence::finish_to_start)
+        {
+            const std::uint64_t _predecessor = find_key(a_predecessor);
+            const std::uint64_t _successor = find_key(a_successor);
+            const std::uint64_t _key = find_key(link_of(a_predecessor, a_successor, a_relation));
+            const auto [_first, _last] = __constraints.equal_range(_key);
+            const auto _search = std::find_if(_first, _last, [&](const auto& c) { return c.second.binds(_predecessor, _successor, a_relation); });
+            if (_search == _last)
+                return *this;
+            if (bounds_finish(a_relation))
+            {
+                const auto [_first_bound, _last_bound] = __finish_bounds.equal_range(_successor);
+                __finish_bounds.erase(std::find_if(_first_bound, _last_bound, [_key](const auto& b) { return b.second == _key; }));
+            }
+            __constraints.erase(_search);
+            update_link(_key, __constraints.count(_key) == 0);
+            return *this;
+        };
+
+        /// @brief Get the links of the precedence constraints: the events they bind, as (source, target) activity values, and their lags
+        /// @return the lag of every link
+        std::map<activity, duration> links() const
+        {
+            std::map<activity, duration> _links;
+            for_each_link([&](std::uint64_t a_key, const duration& a_lag) { _links.emplace(to_activity(a_key), a_lag); });
+            return _links;
+        };
+
+        /// @brief Get the precedence constraints of the network, in no particular order
+        std::vector<precedence_constraint> constraints() const
+        {
+            std::vector<precedence_constraint> _constraints;
+            _constraints.reserve(__constraints.size());
+            for (const auto& [_key, c]: __constraints)
+                _constraints.push_back({ to_activity(c.predecessor), to_activity(c.successor), c.relation, c.lag });
+            return _constraints;
+        };
+
+        /// @brief Get the lags of the links bounding the finish of an activity (see add_constraint), with the durations of
+        ///        an edit which is not applied to the network, e.g. a scenario: the only lags depending on the activity's duration
+        /// @param an_activity the successor of the finish bounds
+        /// @param a_duration function of an activity returning a pointer to its duration in the edit, nullptr if it is left out
+        /// @return the links and their lags, a link from an event to itself included whatever its lag
+        template<typename Function>
+        std::vector<segment> finish_bound_lags(const activity& an_activity, const Function& a_duration) const
+        {
+            std::vector<segment> _links;
+            const auto [_first, _last] = __finish_bounds.equal_range(find_key(an_activity));
+            for (auto it = _first; it != _last; ++it)
+            {
+                const auto [_begin, _end] = __constraints.equal_range(it->second);
+                duration _lag = std::numeric_limits<duration>::lowest();
+                for (auto c = _begin; c != _end; ++c)
+                {
+                    const duration* _duration = bounds_finish(c->second.relation) ? a_duration(to_activity(c->second.successor)) : nullptr;
+                    _lag = std::max(_lag, _duration != nullptr ? c->second.lag - *_duration : c->second.lag);
+                }
+                _links.emplace_back(to_activity(it->second), _lag);
+            }
+            return _links;
+        };
+
+        /// @brief Set the three point estimate of an activity, adding the activity with its most likely duration if it is not in the network
+        /// @param an_activity the value of the activity which estimate is to be set
+        /// @param an_estimate optimistic, most likely and pessimistic durations, and their law
+        /// @return a reference to this network (for syntactic sugar)
+        network& set_estimate(const activity& an_activity, const estimate& an_estimate)
+        {
+            if (__data.find(find_key(an_activity)) == __data.end())
+                add_activity(an_activity, an_estimate.most_likely);
+            const std::uint64_t _key = find_key(an_activity);
+            if (__data.find(_key) != __data.end())
+                __estimates.insert_or_assign(_key, an_estimate);
+            return *this;
+        };
+
+        /// @brief Get the three point estimate of an activity.
+        ///        Activities without an estimate are certain: all three durations equal their estimated duration.
+        /// @param an_activity the value of the activity which estimate is requested
+        /// @return the estimate of the activity
+        estimate get_estimate(const activity& an_activity) const
+        {
+            auto search = __estimates.find(find_key(an_activity));
+            if (search != __estimates.end())
+                return search->second;
+            const duration _duration = estimated_duration(an_activity);
+            return estimate(_duration, _duration, _duration, distribution::uniform);
+        };
+        
+        /// @brief Set the crash option of an activity of the network
+        /// @param an_activity the value of the activity which crash option is to be set
+        /// @param a_crash shortest duration of the activity and cost per duration unit removed
+        /// @return a reference to this network (for syntactic sugar)
+        network& set_crash(const activity& an_activity, const crash& a_crash)
+        {
+            const std::uint64_t _key = find_key(an_activity);
+            if (__data.find(_key) == __data.end())
+                throw std::out_of_range("activity is not in the network");
+            __crashes.insert_or_assign(_key, a_crash);
+            return *this;
+        };
+
+        /// @brief Get the crash option of an activity
+        /// @param an_activity the value of the activity which crash option is requested
+        /// @return the crash option, none if the activity cannot be crashed
+        std::optional<crash> get_crash(const activity& an_activity) const
+        {
+            auto search = __crashes.find(find_key(an_activity));
+            if (search == __crashes.end())
+                return std::nullopt;
+            return search->second;
+        };
+
+        /// @brief Get the estimated duration of an activity in the network
+        /// @param an_activity the value of the activity which duration is requested
+        /// @return the duration of the activity
+        duration estimated_duration(const activity& an_activity) const
+        {
+            // DEBUG ?
+            // TODO: throw an exception
+            auto search_activity = __data.find(find_key(an_activity));
+            if (search_activity == __data.end())
+                return -1;
+
+            return search_activity->second;
+        };
+
+        /// @brief Set the estimated duration of an activity in the network
+        ///        When event times are cached, only the events downstream (earliest) and upstream (latest) of the activity are rescheduled.
+        /// @param an_activity the value of the activity which duration is to be set
+        /// @param a_duration the duration of the activity
+        void set_estimated_duration(const activity& an_activity, const duration& a_duration)
+        {
+            // TODO: throw exception if activity is not present
+            const std::uint64_t _key = intern_key(an_activity);
+            auto search = __data.find(_key);
+            if (search == __data.end())
+            {
+                __data.emplace(_key, a_duration);
+                reschedule_topology(an_activity);
+                update_finish_bounds(_key, true);
+                return;
+            }
+            search->second = a_duration;
+
+            // topology is unchanged: patch the compiled snapshot in place
+            if (__adjacency)
+            {
+                const index _activity = locate_activity(*__adjacency, an_activity);
+                __adjacency->durations[_activity] = a_duration;
+                if (__times)
+                {
+                    if (__tracking)
+                        record_activity(_activity);
+                    propagate_earliest(&__adjacency->completions[_activity], &__adjacency->completions[_activity] + 1, 0);
+                    propagate_latest(&__adjacency->triggers[_activity], &__adjacency->triggers[_activity] + 1, 0);
+                }
+            }
+            update_finish_bounds(_key, false);
+        };
+
+        /// @brief Start or stop recording the events and activities which times are moved by network edits.
+        ///        Only edits made while event times are cached are recorded.
+        /// @param enabled true to record changes
+        void track_changes(bool enabled)
+        {
+            __tracking = enabled;
+        };
+
+        /// @brief Get the events and activities which times moved since the last call to clear_changes
+        /// @return the recorded changes
+        const changes& changed() const
+        {
+            flush_changes();
+            return __changes;
+        };
+
+        /// @brief Forget recorded changes
+        void clear_changes()
+        {
+            for (const index e: __pending_events)
+                __event_marks[e] = 0;
+            for (const index a: __pending_activities)
+                __activity_marks[a] = 0;
+            __pending_events.clear();
+            __pending_activities.clear();
+            __changes.events.clear();
+            __changes.activities.clear();
+        };
+
+        /// @brief A network is well formed if it contains no loop, exactly one start event and exactly one terminal event.
+        /// @return true if the network is well formed, false otherwise.
+        bool is_well_formed() const
+        {
+            PERT_STATS(++stats().validations; const phase_timer _timer(stats().validate_ns);)
+            const adjacency& _adjacency = compiled();
+
+            // check ends
+            if (_adjacency.initial.size() != 1 or _adjacency.terminal.size() != 1)
+                return false;
+            
+            // check loops: the topological order misses every event on or after a loop
+            return _adjacency.acyclic();
+        };
+
+        /// @brief Validate the network in linear time, listing its ends and its loops.
+        ///        Loops are found as the strongly connected components of the network (Tarjan).
+        /// @return a validation report
+        validation validate() const
+        {
+            PERT_STATS(++stats().validations; const phase_timer _timer(stats().validate_ns);)
+            const adjacency& _adjacency = compiled();
+            validation _validation;
+            for (const auto e: _adjacency.initial)
+                _validation.initial_events.push_back(_adjacency.events[e]);
+            for (const auto e: _adjacency.terminal)
+                _validation.terminal_events.push_back(_adjacency.events[e]);
+            if (_adjacency.acyclic())
+                return _validation;
+
+            // only events left out of the topological order can be on a loop
+            std::vector<index> _components = strong_components(_adjacency);
+            std::vector<std::vector<index>> _members;
+            for (index e = 0; e < _adjacency.event_count(); ++e)
+            {
+                if (_components[e] == adjacency::npos)
+                    continue;
+                if (_components[e] >= _members.size())
+                    _members.resize(_components[e] + 1);
+                _members[_components[e]].push_back(e);
+            }
+
+            std::vector<index> _parents(_adjacency.event_count(), adjacency::npos);
+            for (const auto& m: _members)
+            {
+                // a single event is a loop only through an activity or a link to itself
+                const index _root = m.front();
+                bool _self_loop = false;
+                for (index k = _adjacency.out_edge_begin(_root); k != _adjacency.out_edge_end(_root); ++k)
+                    _self_loop = _self_loop or _adjacency.completions[_adjacency.out_edge(k)] == _root;
+                if (m.size() == 1 and not _self_loop)
+                    continue;
+
+                std::vector<event> _events;
+                for (const auto e: m)
+                    _events.push_back(_adjacency.events[e]);
+                _validation.components.push_back(std::move(_events));
+                _validation.loops.push_back(witness_loop(_adjacency, _components, _root, _parents));
+            }
+            return _validation;
+        };
+
+        /// @brief Get the initial events of the network (single element list for well formed network)
+        ///        An initial event is an event with no predecessor activity.
+        /// @return a set of events (unique by definition)
+        std::set<event> initial_events() const
+        {
+            const adjacency& _adjacency = compiled();
+            std::set<event> _initial_events;
+            for (const auto e: _adjacency.initial)
+                _initial_events.emplace_hint(_initial_events.end(), _adjacency.events[e]);
+            return _initial_events;
+        };
+
+        /// @brief Get the terminal events of the network (single element list for well formed network)
+        ///        A terminal event is an event with no successor activity.
+        /// @return a set of events (unique by definition)
+        std::set<event> terminal_events() const
+        {
+            const adjacency& _adjacency = compiled();
+            std::set<event> _terminal_events;
+            for (const auto e: _adjacency.terminal)
+                _terminal_events.emplace_hint(_terminal_events.end(), _adjacency.events[e]);
+            return _terminal_events;
+        };
+
+        /// @brief Get the compiled adjacency snapshot of the network.
+        ///        The snapshot is built on first use and rebuilt after the network topology changes.
+        ///        Build it once (by calling this) before sharing a const network between threads.
+        /// @return a read-only reference to the snapshot, valid until the network is modified
+        const adjacency& compiled() const
+        {
+            if (not __adjacency)
+                __adjacency.emplace(compile());
+            return *__adjacency;
+        };
+
+        /// @brief Get the earliest and latest occurence times of all events.
+        ///        Both passes run once, in topological order, and their results are cached until the network
+        ///        or its schedule is modified.
+        /// @return a read-only reference to the event times, indexed like compiled().events
+        const event_times& times() const
+        {
+            if (not __times)
+                __times.emplace(compute_times(compiled()));
+            return *__times;
+        };
+
+        /// @brief Get the earliest and latest occurence times of all events, computed level by level on a thread pool
+        ///        when they are not cached (see compute_times). The times are the same as times() bit for bit.
+        /// @param a_pool thread pool running the wide levels
+        /// @return a read-only reference to the event times, indexed like compiled().events
+        const event_times& times(thread_pool& a_pool) const
+        {
+            if (not __times)
+                __times.emplace(compute_times(compiled(), a_pool));
+            return *__times;
+        };
+
+        /// @brief Get the earliest and latest occurence times of all events, computed level by level on a thread pool
+        ///        of its own when they are not cached
+        /// @param threads number of threads, 0 for every hardware thread
+        /// @return a read-only reference to the event times, indexed like compiled().events
+        const event_times& times(unsigned threads) const
+        {
+            if (__times or threads == 1)
+                return times();
+            thread_pool _pool(threads);
+            return times(_pool);
+        };
+
+
+        // schedule
+        //---------------------
+
+        /// @brief Set net earliest start time and latest finish time.
+        ///        A network should be properly scheduled before it can be simulated
+        /// @param an_initial_time an initial time
+        /// @param a_terminal_time a terminal time
+        void schedule(const duration& an_initial_time, const duration& a_terminal_time)
+        {
+            __initial_time = an_initial_time;
+            __terminal_time = a_terminal_time;
+            __times.reset();
+        };
+
+        /// @brief Get the network scheduled earliest start time
+        /// @return an initial duration value
+        duration initial_time() const
+        {
+            return __initial_time;
+        };
+
+        /// @brief Get the network scheduled earliest start time
+        /// @return a terminal duration value
+        duration terminal_time() const
+        {
+            return __terminal_time;
+        };
+        
+        /// @brief Get the slack of an activity
+        /// @param an_activity activity object value which slack is computed
+        /// @return slack (duration) of the activity
+        duration activity_float(const activity& an_activity) const
+        {
+            return earliest_occurence(an_activity.completion_event()) - earliest_finish(an_activity);
+        };
+
+        /// @brief Get the free float of an activity
+        /// @param an_activity activity object value which slack is computed
+        /// @return free float (duration) of the activity
+        duration free_float(const activity& an_activity) const
+        {
+            return latest_occurence(an_activity.completion_event()) - earliest_finish(an_activity);
+        };
+
+        /// @brief Get the interfering float of an activity
+        /// @param an_activity id of the activity which interfering float is computed
+        /// @return interfering float (duration) of the activity
+        duration interfering_float(const activity& an_activity) const
+        {
+            return std::max(0, earliest_occurence(an_activity.completion_event()) - latest_occurence(an_activity.trigger_event()) - estimated_duration(an_activity));
+        };
+
+        /// @brief Get the independent float of an activity
+        /// @param an_activity id of the activity which independent float is computed
+        /// @return independent float of the activity
+        duration independent_float(const activity& an_activity) const
+        {
+            return free_float(an_activity) - activity_float(an_activity);
+        };
+
+        /// @brief Get the dates and floats of every activity at once.
+        ///        Each value follows the formula of its single activity accessor, read from the cached event times.
+        /// @return the report columns, indexed like compiled().activities
+        float_report floats() const
+        {
+            PERT_STATS(++stats().float_reports;)
+            const adjacency& _adjacency = compiled();
+            const event_times& _times = times();
+            const std::size_t _count = _adjacency.activity_count();
+            float_report _report(get_memory_resource());
+            for (auto* _column: { &_report.earliest_start, &_report.earliest_finish, &_report.latest_start, &_report.latest_finish,
+                                  &_report.activity_float, &_report.free_float, &_report.interfering_float, &_report.independent_float })
+                _column->resize(_count);
+            for (index a = 0; a < _count; ++a)
+            {
+                const duration _duration = _adjacency.durations[a];
+                const duration _trigger_earliest = _times.earliest[_adjacency.triggers[a]];
+                const duration _trigger_latest = _times.latest[_adjacency.triggers[a]];
+                const duration _completion_earliest = _times.earliest[_adjacency.completions[a]];
+                const duration _completion_latest = _times.latest[_adjacency.completions[a]];
+                _report.earliest_start[a] = _trigger_earliest;
+                _report.earliest_finish[a] = _trigger_earliest + _duration;
+                _report.latest_finish[a] = _completion_latest;
+                _report.latest_start[a] = _completion_latest - _duration;
+                _report.activity_float[a] = _completion_earliest - _report.earliest_finish[a];
+                _report.free_float[a] = _completion_latest - _report.earliest_finish[a];
+                _report.interfering_float[a] = std::max(duration(0), _completion_earliest - _trigger_latest - _duration);
+                _report.independent_float[a] = _report.free_float[a] - _report.activity_float[a];
+            }
+            return _report;
+        };
+
+        /// @brief Get the duration sensitivity of every activity (see sensitivity_report), in O(V+E) plus O(P log P)
+        ///        for a critical path of P activities, from the cached event times.
+        ///        Shortening an activity advances the completion only if the activity is on every longest path. Such an
+        ///        activity is on the critical path of find_critical_path, and its relief is the gap to the longest path
+        ///        avoiding it. Along the topological order, every path crosses the boundary after an event exactly once,
+        ///        so the longest path avoiding the critical activity leaving that event is the longest path through the
+        ///        other activities (or schedule ends) crossing the boundary: one range maximum per crossing activity.
+        ///        Finish to finish and start to finish constraints are not supported: the lag of their link shrinks as the
+        ///        successor lasts longer, so that shortening the successor may delay the completion.
+        /// @return the report columns, indexed like compiled().activities
+        /// @throw std::logic_error if the network contains a loop
+        /// @throw std::invalid_argument if the network has finish to finish or start to finish constraints
+        sensitivity_report sensitivity() const
+        {
+            if (not __finish_bounds.empty())
+                throw std::invalid_argument("sensitivity does not support finish to finish or start to finish constraints");
+            const adjacency& _adjacency = compiled();
+            const event_times& _times = times();
+            const std::size_t _event_count = _adjacency.event_count();
+            const std::size_t _count = _adjacency.activity_count();
+            sensitivity_report _report(get_memory_resource());
+            for (auto* _column: { &_report.total_float, &_report.lower, &_report.upper, &_report.relief })
+                _column->resize(_count);
+
+            // completion and longest tail from each event to a terminal event, precedence constraint links being
+            // edges of the paths like activities
+            _report.completion = __initial_time;
+            for (const index e: _adjacency.terminal)
+                _report.completion = std::max(_report.completion, _times.earliest[e]);
+            const std::size_t _edge_count = _adjacency.triggers.size();
+            std::pmr::vector<duration> _tails(_event_count, duration(0), get_memory_resource());
+            for (auto it = _adjacency.order.crbegin(); it != _adjacency.order.crend(); ++it)
+            {
+                for (index k = _adjacency.out_edge_begin(*it); k != _adjacency.out_edge_end(*it); ++k)
+                {
+                    const index a = _adjacency.out_edge(k);
+                    const duration _tail = _adjacency.durations[a] + _tails[_adjacency.completions[a]];
+                    _tails[*it] = k == _adjacency.out_edge_begin(*it) ? _tail : std::max(_tails[*it], _tail);
+                }
+            }
+            const auto _through = [&](index an_edge)
+            {
+                return _times.earliest[_adjacency.triggers[an_edge]] + _adjacency.durations[an_edge] + _tails[_adjacency.completions[an_edge]];
+            };
+
+            // critical path, as find_critical_path, and the boundary after the source of each of its edges
+            std::vector<index> _chain;
+            const std::pmr::vector<index> _terminal = critical_terminal_events(_adjacency, _times);
+            for (index e = _terminal.empty() ? adjacency::npos : _terminal.front(); e != adjacency::npos; )
+            {
+                const index* _tight = std::find_if(_adjacency.in_begin(e), _adjacency.in_end(e), [&](index a) { return tight(_adjacency, _times, a); });
+                if (_tight == _adjacency.in_end(e))
+                    break;
+                _chain.push_back(*_tight);
+                e = _adjacency.triggers[*_tight];
+            }
+            std::reverse(_chain.begin(), _chain.end());
+            std::vector<char> _on_chain(_edge_count, 0);
+            std::vector<index> _next_query(_event_count + 1, adjacency::npos), _previous_query(_event_count, adjacency::npos);
+            for (index i = 0; i < _chain.size(); ++i)
+            {
+                _on_chain[_chain[i]] = 1;
+                _next_query[_adjacency.rank[_adjacency.triggers[_chain[i]]]] = i;
+            }
+            for (index r = _event_count; r-- > 0; )
+                _next_query[r] = _next_query[r] != adjacency::npos ? _next_query[r] : _next_query[r + 1];
+            for (index r = 0, i = adjacency::npos; r < _event_count; ++r)
+            {
+                i = _next_query[r] != adjacency::npos and _adjacency.rank[_adjacency.triggers[_chain[_next_query[r]]]] == r ? _next_query[r] : i;
+                _previous_query[r] = i;
+            }
+
+            // longest crossing path at each boundary: range maxima over the boundaries, on a sparse table pushed down at the end
+            const duration _none = std::numeric_limits<duration>::lowest();
+            std::size_t _levels = 1;
+            while ((std::size_t(1) << _levels) <= _chain.size())
+                ++_levels;
+            std::vector<std::vector<duration>> _crossing(_levels, std::vector<duration>(_chain.size(), _none));
+            const auto _cross = [&](index a_first, index a_last, const duration& a_length)
+            {
+                // boundaries a_first to a_last, the boundary r lying after the event of rank r
+                if (a_first > a_last or a_first >= _event_count)
+                    return;
+                const index _low = _next_query[a_first];
+                const index _high = _previous_query[std::min<index>(a_last, _event_count - 1)];
+                if (_low == adjacency::npos or _high == adjacency::npos or _low > _high)
+                    return;
+                std::size_t _level = 0;
+                while ((std::size_t(2) << _level) <= _high - _low + 1)
+                    ++_level;
+                duration& _left = _crossing[_level][_low];
+                duration& _right = _crossing[_level][_high + 1 - (std::size_t(1) << _level)];
+                _left = std::max(_left, a_length);
+                _right = std::max(_right, a_length);
+            };
+            if (not _chain.empty())
+            {
+                // paths start at the initial time on initial events, and on the targets of links (see earliest_occurence)
+                for (const index e: _adjacency.initial)
+                    if (_adjacency.rank[e] > 0)
+                        _cross(0, _adjacency.rank[e] - 1, _times.earliest[e] + _tails[e]);
+                for (index e = 0; e < _event_count; ++e)
+                    if (_adjacency.in_begin(e) != _adjacency.in_end(e) and _adjacency.is_link(_adjacency.in_end(e)[-1]) and _adjacency.rank[e] > 0)
+                        _cross(0, _adjacency.rank[e] - 1, __initial_time + _tails[e]);
+                for (const index e: _adjacency.terminal)
+                    _cross(_adjacency.rank[e], _event_count - 1, _times.earliest[e]);
+                for (index a = 0; a < _edge_count; ++a)
+                    if (not _on_chain[a])
+                        _cross(_adjacency.rank[_adjacency.triggers[a]], _adjacency.rank[_adjacency.completions[a]] - 1, _through(a));
+                for (std::size_t _level = _levels; _level-- > 1; )
+                    for (index i = 0; i + (std::size_t(1) << _level) <= _chain.size(); ++i)
+                    {
+                        const std::size_t _half = std::size_t(1) << (_level - 1);
+                        _crossing[_level - 1][i] = std::max(_crossing[_level - 1][i], _crossing[_level][i]);
+                        _crossing[_level - 1][i + _half] = std::max(_crossing[_level - 1][i + _half], _crossing[_level][i]);
+                    }
+            }
+
+            for (index a = 0; a < _count; ++a)
+            {
+                const duration _duration = _adjacency.durations[a];
+                _report.total_float[a] = _report.completion - _through(a);
+                _report.lower[a] = _report.total_float[a] > duration(0) ? std::min(duration(0), _duration) : _duration;
+                _report.upper[a] = _duration + _report.total_float[a];
+                _report.relief[a] = duration(0);
+            }
+            for (index i = 0; i < _chain.size(); ++i)
+            {
+                if (_chain[i] >= _count)
+                    continue;
+                const duration _avoiding = _crossing[0][i];
+                const duration _duration = _adjacency.durations[_chain[i]];
+                _report.relief[_chain[i]] = _avoiding == _none ? _duration : std::max(duration(0), std::min(_duration, _report.completion - _avoiding));
+            }
+            return _report;
+        };
+
+        // - forward pass
+        
+        /// @brief Get the earliest occurence of an event
+        /// @param an_event event id
+        /// @return earliest occurence date
+        duration earliest_occurence(const event& an_event) const
+        {
+            PERT_STATS(++stats().occurence_queries;)
+            const event_times& _times = times();
+            return _times.earliest[checked_index(compiled(), an_event)];
+        };
+        
+        /// @brief Get the earliest finish date of an activity
+        /// @param an_activity activity object value which earliest finish date is to be computed
+        /// @return earliest finish date of the parameter activity
+        duration earliest_finish(const activity& an_activity) const
+        {
+            // earliest occurence of trigger + estimated duration
+            return earliest_occurence(an_activity.trigger_event()) + estimated_duration(an_activity);
+        };
+
+        // - backward pass
+        
+        /// @brief Get the latest occurence date of an event
+        /// @param an_event event id
+        /// @return latest occurence date of the parameter event
+        duration latest_occurence(const event& an_event) const
+        {
+            PERT_STATS(++stats().occurence_queries;)
+            const event_times& _times = times();
+            return _times.latest[checked_index(compiled(), an_event)];
+        };
+        
+        /// @brief Get the latest start of an activity
+        /// @param an_activity activity object value which latest start date is to be computed
+        /// @return latest start date of parameter activity
+        duration latest_start(const activity& an_activity) const
+        {
+            // latest occurence of completion - estimated duration
+            return latest_occurence(an_activity.completion_event()) - estimated_duration(an_activity);
+        };
+
+        // critical path
+        //---------------------
+
+        /// @brief Find a critical path of the network: a chain of tight activities (earliest finish equal to the earliest
+        ///        occurence of their completion event) from an initial event to the terminal event that occurs last.
+        ///        The chain is rebuilt by walking tight incoming activities back from that terminal event, in O(V+E).
+        ///        Ties go to the first terminal event and to the first tight incoming activity, in compiled() order.
+        ///        Tight precedence constraint links come after activities, as segments between their events with their lag.
+        /// @return list of activity segments ordered by precedence, empty if the network has no activity
+        path find_critical_path() const
+        {
+            PERT_STATS(++stats().critical_path_searches; const phase_timer _timer(stats().critical_path_ns);)
+            const adjacency& _adjacency = compiled();
+            const event_times& _times = times();
+            path _critical_path(get_memory_resource());
+            const std::pmr::vector<index> _terminal = critical_terminal_events(_adjacency, _times);
+            if (_terminal.empty())
+                return _critical_path;
+            for (index e = _terminal.front(); ; )
+            {
+                const index* _tight = std::find_if(_adjacency.in_begin(e), _adjacency.in_end(e), [&](index a) { return tight(_adjacency, _times, a); });
+                PERT_STATS(++stats().events_visited; stats().edges_visited += _tight - _adjacency.in_begin(e);)
+                if (_tight == _adjacency.in_end(e))
+                    break;
+                _critical_path.push_back(edge_segment(_adjacency, *_tight));
+                e = _adjacency.triggers[*_tight];
+            }
+            std::reverse(_critical_path.begin(), _critical_path.end());
+            return _critical_path;
+        };
+
+        /// @brief Find every critical path of the network, when ties give several critical chains.
+        ///        Only tight activities leading to a last terminal event are explored, so the cost is O(V+E) plus the output size.
+        /// @return list of critical paths, each ordered by precedence, sorted
+        std::vector<path> critical_paths() const
+        {
+            PERT_STATS(++stats().critical_path_searches; const phase_timer _timer(stats().critical_path_ns);)
+            const adjacency& _adjacency = compiled();
+            const event_times& _times = times();
+            std::vector<path> _paths;
+            // depth first search backwards: each frame holds an event and its next incoming edge slot to explore
+            std::vector<std::pair<index, const index*>> _stack;
+            std::vector<index> _chain;
+            for (const index _terminal: critical_terminal_events(_adjacency, _times))
+            {
+                _stack.emplace_back(_terminal, _adjacency.in_begin(_terminal));
+                while (not _stack.empty())
+                {
+                    const index e = _stack.back().first;
+                    const index* _next = std::find_if(_stack.back().second, _adjacency.in_end(e), [&](index a) { return tight(_adjacency, _times, a); });
+                    PERT_STATS(++stats().events_visited;)
+                    if (_stack.back().second == _adjacency.in_begin(e) and _next == _adjacency.in_end(e))
+                    {
+                        // no tight incoming edge, e.g. an initial event: the chain is complete
+                        path& _path = _paths.emplace_back();
+                        for (auto it = _chain.crbegin(); it != _chain.crend(); ++it)
+                            _path.push_back(edge_segment(_adjacency, *it));
+                    }
+                    if (_next == _adjacency.in_end(e))
+                    {
+                        _stack.pop_back();
+                        if (not _chain.empty())
+                            _chain.pop_back();
+                        continue;
+                    }
+                    _stack.back().second = _next + 1;
+                    _chain.push_back(*_next);
+                    _stack.emplace_back(_adjacency.triggers[*_next], _adjacency.in_begin(_adjacency.triggers[*_next]));
+                }
+            }
+            std::sort(_paths.begin(), _paths.end());
+            return _paths;
+        };
+
+        /// @brief Get displayable string of an activity segment
+        /// @param a_segment the segment object to be stringified
+        /// @return a string representing the activity segment
+        static std::string to_str(const segment& a_segment)
+        {
+            std::stringstream str_stream; 
+            str_stream << "[" << a_segment.first.trigger_event() << "]" << " --=" << a_segment.second << "=--> " << "[" << a_segment.first.completion_event() << "]";
+            return str_stream.str();
+        }
+
+        /// @brief Get list of paths between two events
+        /// @param a_start_event the start event of the paths
+        /// @param a_finish_event the finish event of the paths
+        /// @return a list of paths from a_start_event to a_finish_event
+        std::vector<path> paths(const event& a_start_event, const event& a_finish_event) const
+        {
+            return paths(path({}), a_start_event, a_finish_event);
+        }
+
+        /// @brief Assuming a partial path has already been found up until a current event, list eventual paths starting with the partial path and leading to a finish event.
+        /// @param a_partial_path path already browsed up to the current event
+        /// @param the_current_event the completion event of the partial path's last activity segment
+        /// @param a_finish_event the finish event aimed by the partial path
+        /// @return the list of paths from the current event to the finish event prepended with the partial path
+        std::vector<path> paths(const path& a_partial_path, const event& the_current_event, const event& a_finish_event) const
+        {
+            // TODO: check that the current event is the last segment's completion event
+            path_range _range(compiled(), a_partial_path, the_current_event, a_finish_event);
+            return std::vector<path>(_range.begin(), _range.end());
+        };
+
+        /// @brief Enumerate the paths between two events lazily, one at a time, without storing them
+        /// @param a_start_event the start event of the paths
+        /// @param a_finish_event the finish event of the paths
+        /// @return a range of paths from a_start_event to a_finish_event, in the order of paths()
+        path_range enumerate_paths(const event& a_start_event, const event& a_finish_event) const
+        {
+            return path_range(compiled(), path({}), a_start_event, a_finish_event);
+        };
+
+        /// @brief Count the paths between two events and find their shortest and longest lengths, without enumerating them.
+        ///        One dynamic programming sweep runs over the events ranked between both events in topological order.
+        /// @param a_start_event the start event of the paths
+        /// @param a_finish_event the finish event of the paths
+        /// @return the number of paths (saturated) and their shortest and longest lengths
+        /// @throw std::logic_error if the network contains a loop
+        path_summary summarize_paths(const event& a_start_event, const event& a_finish_event) const
+        {
+            const adjacency& _adjacency = compiled();
+            if (not _adjacency.acyclic())
+                throw std::logic_error("network contains a loop");
+            path_summary _summary { 0, duration(0), duration(0) };
+            const index _start = locate(_adjacency, a_start_event);
+            const index _finish = locate(_adjacency, a_finish_event);
+            if (_start == adjacency::npos or _finish == adjacency::npos or _adjacency.rank[_finish] <= _adjacency.rank[_start])
+                return _summary;
+
+            // counts and lengths of the paths from the start event, indexed by rank offset from the start event
+            const index _first = _adjacency.rank[_start];
+            const index _last = _adjacency.rank[_finish];
+            std::vector<path_summary> _events(_last - _first + 1, path_summary { 0, duration(0), duration(0) });
+            _events[0].count = 1;
+            for (index r = _first; r < _last; ++r)
+            {
+                const path_summary& _from = _events[r - _first];
+                if (_from.count == 0)
+                    continue;
+                const index e = _adjacency.order[r];
+                for (index a = _adjacency.out_begin(e); a != _adjacency.out_end(e); ++a)
+                {
+                    const index _rank = _adjacency.rank[_adjacency.completions[a]];
+                    if (_rank > _last)
+                        continue;
+                    path_summary& _to = _events[_rank - _first];
+                    const duration _shortest = _from.shortest + _adjacency.durations[a];
+                    const duration _longest = _from.longest + _adjacency.durations[a];
+                    _to.shortest = _to.count == 0 ? _shortest : std::min(_to.shortest, _shortest);
+                    _to.longest = _to.count == 0 ? _longest : std::max(_to.longest, _longest);
+                    _to.count = _to.count > std::numeric_limits<std::uint64_t>::max() - _from.count ? std::numeric_limits<std::uint64_t>::max() : _to.count + _from.count;
+                }
+            }
+            return _events.back();
+        };
+
+        /// @brief Count the paths between two events, without enumerating them (see summarize_paths)
+        /// @return the number of paths, saturated at the largest std::uint64_t
+        std::uint64_t count_paths(const event& a_start_event, const event& a_finish_event) const
+        {
+            return summarize_paths(a_start_event, a_finish_event).count;
+        };
+
+        /// @brief Get the list of loops in between two events of the network
+        /// @param a_start_event the start event 
+        /// @param a_finish_event the finish event
+        /// @return list of loop paths found in between two events
+        std::vector<path> loop_paths(const event& a_start_event, const event& a_finish_event) const
+        {
+            return loop_paths(path({}), a_start_event, a_finish_event);
+        }
+
+        /// @brief Assuming a partial path has already been found up until a current event, list eventual loop paths starting with the partial path.
+        /// @param a_partial_path path already browsed up to the current event (has no loops and has not reach finish event)
+        /// @param the_current_event the completion event of the partial path's last activity segment 
+        /// @param a_finish_event the finish event of the loop paths search
+        /// @return list of loop paths in between the current event and the finish event
+        std::vector<path> loop_paths(const path& a_partial_path, const event& the_current_event, const event& a_finish_event) const
+        {
+            std::vector<path> _paths;
+            const adjacency& _adjacency = compiled();
+            const auto _current = _adjacency.event_index(the_current_event);
+            if (_current == adjacency::npos)
+                return _paths;
+
+            // the finish event may lie outside the network, in which case no branch stops on it
+            path _stack { a_partial_path };
+            std::vector<bool> _on_stack(_adjacency.event_count(), false);
+            mark_triggers(_adjacency, _stack, _on_stack);
+            collect_loop_paths(_adjacency, _stack, _on_stack, _current, _adjacency.event_index(a_finish_event), _paths);
+            return _paths;
+        };
+
+
+        // Constructors
+        //---------------------
+
+        /// @brief Construct empty network
+        network() : network(default_resource()) {};
+
+        /// @brief Construct an empty network which storage and scratch buffers come from a memory resource.
+        ///        With a monotonic resource (see arena), building and analysing a network makes no global allocation.
+        ///        The resource must outlive the network; copies of the network use the default resource.
+        /// @param a_resource memory resource of the network
+        explicit network(std::pmr::memory_resource* a_resource) :
+            __events(a_resource),
+            __data(a_resource),
+            __estimates(a_resource),
+            __crashes(a_resource),
+            __constraints(a_resource),
+            __finish_bounds(a_resource),
+            __pending_events(a_resource),
+            __pending_activities(a_resource),
+            __event_marks(a_resource),
+            __activity_marks(a_resource),
+            __scratch_heap(a_resource),
+            __scratch_queued(a_resource)
+        {};
+
+        /// @brief Get the memory resource of default constructed networks: the default resource, seen through
+        ///        the allocation counters when statistics are enabled
+        static std::pmr::memory_resource* default_resource()
+        {
+#ifdef PERT_CPM_STATS
+            static statistics_resource _resource;
+            return &_resource;
+#else
+            return std::pmr::get_default_resource();
+#endif
+        };
+
+        /// @brief Get the memory resource of the network's storage and scratch buffers
+        std::pmr::memory_resource* get_memory_resource() const
+        {
+            return __data.get_allocator().resource();
+        };
+
+        /// @brief Construct a network from a list of paths
+        /// @param some_paths list of paths to include in network
+        network(const std::vector<path>& some_paths) : network()
+        {
+            for (const path& p: some_paths)
+            {
+                for (const segment& s: p)
+                {
+                    this->add_activity(s.first, s.second);
+                }
+            }
+        };
+
+        /// @brief Construct a network from a list of paths and a schedule
+        /// @param some_paths list of paths to include in network
+        /// @param a_start_time scheduled earliest start time of the network project
+        /// @param a_finish_time scheduled latest finish time of the network project
+        network(const std::vector<path>& some_paths, const duration& a_start_time, const duration& a_finish_time) : network(some_paths) 
+        {
+            __initial_time = a_start_time;
+            __terminal_time = a_finish_time;
+        };
+        
+        /// @brief Subset of network made of activities in between two events, as a view over this network (see subnet_view)
+        /// @param a_start_event event id of the subnet's initial event
+        /// @param a_finish_event event id of the subnet's terminal event
+        /// @return a partial network view, materialize() it for an owned network
+        /// @throw std::invalid_argument if the network has precedence constraints
+        subnet_view subnet(const event& a_start_event, const event& a_finish_event) const
+        {
+            return subnet_view(*this, a_start_event, a_finish_event);
+        }
+
+        // automation
+        //---------------------
+        
+        /// @brief create network object from a network description as string
+        /// @param txt string representation of network
+        /// @return network object
+        static network from_txt(const std::string& txt)
+        {
+            return from_txt(std::string_view(txt));
+        };
+
+        /// @brief create network object from a network description.
+        ///        The description holds the initial time, the terminal time, then one "trigger completion duration" line per activity
+        ///        and one "relation trigger completion trigger completion [lag]" line per precedence constraint (see add_constraint),
+        ///        the relation being FS, SS, FF or SF and the activities the predecessor then the successor.
+        ///        Lines are parsed in parallel on line aligned chunks, then the network is built at once.
+        /// @param txt network description, e.g. a memory mapped file
+        /// @param threads number of parsing threads, 0 for every hardware thread
+        /// @return network object
+        /// @throw parse_error listing the malformed lines
+        static network from_txt(std::string_view txt, unsigned threads = 1)
+        {
+            PERT_STATS(++stats().parses; const phase_timer _timer(stats().parse_ns);)
+            network txt_network;
+            std::vector<parse_error::line> _errors;
+
+            // Get schedule times
+            std::size_t _position = 0;
+            duration _times[2] {};
+            for (std::size_t i = 0; i < 2; ++i)
+            {
+                const std::string_view _line = next_line(txt, _position);
+                std::string_view _tokens[2];
+                if (split(_line, _tokens, 2) != 1 or not parse_token(_tokens[0], _times[i]))
+                    _errors.push_back({ i + 1, std::string(_line), i == 0 ? "expected an initial time" : "expected a terminal time" });
+            }
+            txt_network.schedule(_times[0], _times[1]);
+
+            // Split activity lines into line aligned chunks
+            const std::string_view _body = txt.substr(std::min(_position, txt.size()));
+            if (threads == 0)
+                threads = std::max(1u, std::thread::hardware_concurrency());
+            const std::size_t _chunk_count = std::max<std::size_t>(1, std::min<std::size_t>(threads, _body.size() / (1 << 16)));
+            std::vector<std::string_view> _chunks;
+            for (std::size_t c = 0, _begin = 0; c < _chunk_count; ++c)
+            {
+                std::size_t _end = _body.size() * (c + 1) / _chunk_count;
+                if (_end < _body.size())
+                    _end = std::min(_body.size(), _body.find('\n', _end) + 1);
+                if (_end == 0)
+                    _end = _body.size();
+                if (_end > _begin)
+                    _chunks.push_back(_body.substr(_begin, _end - _begin));
+                _begin = std::max(_begin, _end);
+            }
+
+            // Get activities
+            std::vector<std::vector<segment>> _segments(_chunks.size());
+            std::vector<std::vector<precedence_constraint>> _constraints(_chunks.size());
+            std::vector<std::vector<parse_error::line>> _chunk_errors(_chunks.size());
+            std::vector<std::size_t> _line_counts(_chunks.size(), 0);
+            const auto _parse_chunk = [&](std::size_t c)
+            {
+                std::size_t _chunk_position = 0;
+                while (_chunk_position < _chunks[c].size())
+                {
+                    const std::string_view _line = next_line(_chunks[c], _chunk_position);
+                    ++_line_counts[c];
+                    std::string_view _tokens[7];
+                    const std::size_t _token_count = split(_line, _tokens, 7);
+                    if (_token_count == 0)
+                        continue;
+                    event s, f;
+                    duration d;
+                    const auto _relation = std::find(std::begin(__relations), std::end(__relations), _tokens[0]);
+                    if (_relation != std::end(__relations))
+                    {
+                        event s2, f2;
+                        d = duration(0);
+                        if (_token_count != 5 and _token_count != 6)
+                            _chunk_errors[c].push_back({ _line_counts[c], std::string(_line), "expected relation, predecessor, successor and lag" });
+                        else if (not parse_token(_tokens[1], s) or not parse_token(_tokens[2], f) or not parse_token(_tokens[3], s2) or not parse_token(_tokens[4], f2))
+                            _chunk_errors[c].push_back({ _line_counts[c], std::string(_line), "invalid event" });
+                        else if (_token_count == 6 and not parse_token(_tokens[5], d))
+                            _chunk_errors[c].push_back({ _line_counts[c], std::string(_line), "invalid lag" });
+                        else
+                            _constraints[c].push_back({ activity(s, f), activity(s2, f2), static_cast<precedence>(_relation - std::begin(__relations)), d });
+                    }
+                    else if (_token_count != 3)
+                        _chunk_errors[c].push_back({ _line_counts[c], std::string(_line), "expected trigger, completion and duration" });
+                    else if (not parse_token(_tokens[0], s) or not parse_token(_tokens[1], f))
+                        _chunk_errors[c].push_back({ _line_counts[c], std::string(_line), "invalid event" });
+                    else if (not parse_token(_tokens[2], d))
+                        _chunk_errors[c].push_back({ _line_counts[c], std::string(_line), "invalid duration" });
+                    else
+                        _segments[c].emplace_back(activity(s, f), d);
+                }
+            };
+            if (_chunks.size() > 1)
+            {
+                thread_pool _pool(static_cast<unsigned>(_chunks.size()));
+                _pool.parallel_for(_chunks.size(), _parse_chunk);
+            }
+            else if (not _chunks.empty())
+                _parse_chunk(0);
+
+            // Chunk line numbers are made absolute (the schedule takes two lines)
+            std::size_t _first_line = 2;
+            std::vector<segment> _all_segments;
+            _all_segments.reserve(std::accumulate(_segments.cbegin(), _segments.cend(), std::size_t(0), [](std::size_t n, const auto& v) { return n + v.size(); }));
+            for (std::size_t c = 0; c < _chunks.size(); ++c)
+            {
+                for (auto& e: _chunk_errors[c])
+                {
+                    e.number += _first_line;
+                    _errors.push_back(std::move(e));
+                }
+                _first_line += _line_counts[c];
+                _all_segments.insert(_all_segments.end(), _segments[c].cbegin(), _segments[c].cend());
+                std::vector<segment>().swap(_segments[c]);
+            }
+            if (not _errors.empty())
+                throw parse_error(std::move(_errors));
+
+            txt_network.add_activities(std::move(_all_segments));
+            for (const auto& _chunk: _constraints)
+                for (const auto& k: _chunk)
+                    txt_network.add_constraint(k.predecessor, k.successor, k.relation, k.lag);
+            return txt_network;
+        };
+        
+    private:
+
+        /// @brief Keywords of the precedence relations in network descriptions, in precedence order
+        static constexpr std::string_view __relations[] = { "FS", "SS", "FF", "SF" };
+
+        /// @brief Get the line starting at a position of a text, and move the position to the next line
+        static std::string_view next_line(std::string_view a_text, std::size_t& a_position)
+        {
+            if (a_position >= a_text.size())
+                return std::string_view();
+            std::size_t _end = a_text.find('\n', a_position);
+            if (_end == std::string_view::npos)
+                _end = a_text.size();
+            std::string_view _line = a_text.substr(a_position, _end - a_position);
+            a_position = _end + 1;
+            if (not _line.empty() and _line.back() == '\r')
+                _line.remove_suffix(1);
+            return _line;
+        };
+
+        /// @brief Split a line into blank separated tokens
+        /// @param a_line the line
+        /// @param some_tokens output tokens
+        /// @param a_capacity number of tokens to find at most
+        /// @return the number of tokens found (a_capacity if there are more)
+        static std::size_t split(std::string_view a_line, std::string_view* some_tokens, std::size_t a_capacity)
+        {
+            std::size_t _count = 0, i = 0;
+            while (_count < a_capacity)
+            {
+                while (i < a_line.size() and (a_line[i] == ' ' or a_line[i] == '\t'))
+                    ++i;
+                if (i == a_line.size())
+                    break;
+                const std::size_t _begin = i;
+                while (i < a_line.size() and a_line[i] != ' ' and a_line[i] != '\t')
+                    ++i;
+                some_tokens[_count++] = a_line.substr(_begin, i - _begin);
+            }
+            return _count;
+        };
+
+        using index = typename adjacency::index;
+
+        /// @brief Build the adjacency snapshot from the activity map
+        /// @return a compiled adjacency snapshot
+        adjacency compile() const
+        {
+            PERT_STATS(++stats().compilations;)
+            adjacency _adjacency(get_memory_resource());
+
+            // edges as interned event ids, in table order: activities, then the links of the precedence constraints
+            std::pmr::vector<index> _triggers(get_memory_resource()), _completions(get_memory_resource());
+            std::pmr::vector<duration> _durations(get_memory_resource());
+            _triggers.reserve(__data.size() + __constraints.size());
+            _completions.reserve(__data.size() + __constraints.size());
+            _durations.reserve(__data.size() + __constraints.size());
+            for (const auto& a: __data)
+            {
+                _triggers.push_back(trigger_id(a.first));
+                _completions.push_back(completion_id(a.first));
+                _durations.push_back(a.second);
+            }
+            const std::size_t _activity_count = _triggers.size();
+            for_each_link([&](std::uint64_t a_key, const duration& a_lag)
+            {
+                _triggers.push_back(trigger_id(a_key));
+                _completions.push_back(completion_id(a_key));
+                _durations.push_back(a_lag);
+            });
+            const std::size_t _edge_count = _triggers.size();
+
+            // events with edges, sorted by value: events are compared here only, algorithms use indices
+            std::pmr::vector<char> _used(__events.size(), 0, get_memory_resource());
+            for (index k = 0; k < _edge_count; ++k)
+                _used[_triggers[k]] = _used[_completions[k]] = 1;
+            for (event_id i = 0; i < __events.size(); ++i)
+                if (_used[i])
+                    _adjacency.ids.push_back(i);
+            std::sort(_adjacency.ids.begin(), _adjacency.ids.end(), [this](event_id i, event_id j) { return __events[i] < __events[j]; });
+            const std::size_t _event_count = _adjacency.ids.size();
+            _adjacency.slots.assign(__events.size(), adjacency::npos);
+            _adjacency.events.reserve(_event_count);
+            for (index e = 0; e < _event_count; ++e)
+            {
+                _adjacency.slots[_adjacency.ids[e]] = e;
+                _adjacency.events.push_back(__events[_adjacency.ids[e]]);
+            }
+
+            // endpoints as event indices; outgoing activities and incoming edges counted per event,
+            // and outgoing edges if the network has links
+            const bool _linked = _edge_count > _activity_count;
+            _adjacency.out_offsets.assign(_event_count + 1, 0);
+            _adjacency.in_offsets.assign(_event_count + 1, 0);
+            if (_linked)
+                _adjacency.out_edge_offsets.assign(_event_count + 1, 0);
+            for (index k = 0; k < _edge_count; ++k)
+            {
+                _triggers[k] = _adjacency.slots[_triggers[k]];
+                _completions[k] = _adjacency.slots[_completions[k]];
+                if (k < _activity_count)
+                    ++_adjacency.out_offsets[_triggers[k] + 1];
+                if (_linked)
+                    ++_adjacency.out_edge_offsets[_triggers[k] + 1];
+                ++_adjacency.in_offsets[_completions[k] + 1];
+            }
+            for (index e = 0; e < _event_count; ++e)
+            {
+                _adjacency.out_offsets[e + 1] += _adjacency.out_offsets[e];
+                _adjacency.in_offsets[e + 1] += _adjacency.in_offsets[e];
+                if (_linked)
+                    _adjacency.out_edge_offsets[e + 1] += _adjacency.out_edge_offsets[e];
+            }
+
+            // activities, then links, sorted by trigger then completion: counting sort by completion, then stable
+            // counting sort by trigger, links being placed after the activities from the links counted before their trigger
+            std::pmr::vector<index> _by_completion(_edge_count, get_memory_resource());
+            std::pmr::vector<index> _fill(_adjacency.in_offsets.cbegin(), _adjacency.in_offsets.cend() - 1, get_memory_resource());
+            for (index k = 0; k < _edge_count; ++k)
+                _by_completion[_fill[_completions[k]]++] = k;
+            _fill.assign(_adjacency.out_offsets.cbegin(), _adjacency.out_offsets.cend() - 1);
+            std::pmr::vector<index> _link_fill(get_memory_resource());
+            if (_linked)
+            {
+                _link_fill.resize(_event_count);
+                for (index e = 0; e < _event_count; ++e)
+                    _link_fill[e] = _activity_count + _adjacency.out_edge_offsets[e] - _adjacency.out_offsets[e];
+            }
+            _adjacency.triggers.resize(_edge_count);
+            _adjacency.completions.resize(_edge_count);
+            _adjacency.durations.resize(_edge_count);
+            for (const index k: _by_completion)
+            {
+                const index a = k < _activity_count ? _fill[_triggers[k]]++ : _link_fill[_triggers[k]]++;
+                _adjacency.triggers[a] = _triggers[k];
+                _adjacency.completions[a] = _completions[k];
+                _adjacency.durations[a] = _durations[k];
+            }
+            _adjacency.activities.reserve(_activity_count);
+            for (index a = 0; a < _activity_count; ++a)
+                _adjacency.activities.emplace_back(_adjacency.events[_adjacency.triggers[a]], _adjacency.events[_adjacency.completions[a]]);
+
+            // counting sorts of edges by completion event, and by trigger event if the network has links,
+            // so that the slots of an event list its activities first
+            _adjacency.in_edges.resize(_edge_count);
+            _fill.assign(_adjacency.in_offsets.cbegin(), _adjacency.in_offsets.cend() - 1);
+            for (index a = 0; a < _edge_count; ++a)
+                _adjacency.in_edges[_fill[_adjacency.completions[a]]++] = a;
+            if (_linked)
+            {
+                _adjacency.out_edges.resize(_edge_count);
+                _fill.assign(_adjacency.out_edge_offsets.cbegin(), _adjacency.out_edge_offsets.cend() - 1);
+                for (index a = 0; a < _edge_count; ++a)
+                    _adjacency.out_edges[_fill[_adjacency.triggers[a]]++] = a;
+            }
+
+            // network ends: events without incoming (outgoing) edge
+            for (index e = 0; e < _event_count; ++e)
+            {
+                if (_adjacency.in_begin(e) == _adjacency.in_end(e))
+                    _adjacency.initial.push_back(e);
+                if (_adjacency.out_edge_begin(e) == _adjacency.out_edge_end(e))
+                    _adjacency.terminal.push_back(e);
+            }
+
+            // topological order (Kahn), events caught in loops are left out.
+            // Events released while a level is ordered have all their predecessors in that level or before,
+            // so the first in first out order is grouped by level (longest path from an initial event).
+            _adjacency.order.reserve(_event_count);
+            std::pmr::vector<index> _pending(_event_count, get_memory_resource());
+            for (index e = 0; e < _event_count; ++e)
+                _pending[e] = _adjacency.in_offsets[e + 1] - _adjacency.in_offsets[e];
+            _adjacency.order.assign(_adjacency.initial.cbegin(), _adjacency.initial.cend());
+            _adjacency.rank.assign(_event_count, adjacency::npos);
+            _adjacency.levels.assign(1, 0);
+            for (std::size_t i = 0, _level_end = _adjacency.order.size(); i < _adjacency.order.size(); ++i)
+            {
+                if (i == _level_end)
+                {
+                    _adjacency.levels.push_back(i);
+                    _level_end = _adjacency.order.size();
+                }
+                const index e = _adjacency.order[i];
+                _adjacency.rank[e] = i;
+                for (index k = _adjacency.out_edge_begin(e); k != _adjacency.out_edge_end(e); ++k)
+                {
+                    const index _completion = _adjacency.completions[_adjacency.out_edge(k)];
+                    if (--_pending[_completion] == 0)
+                        _adjacency.order.push_back(_completion);
+                }
+            }
+            if (_adjacency.levels.back() != _adjacency.order.size())
+                _adjacency.levels.push_back(_adjacency.order.size());
+
+            return _adjacency;
+        };
+
+        /// @brief Get the index of an event through the event table
+        /// @param an_adjacency compiled adjacency of this network
+        /// @param an_event event id
+        /// @return the event index, npos if the event is not in the network
+        index locate(const adjacency& an_adjacency, const event& an_event) const
+        {
+            const event_id _id = __events.find(an_event);
+            return _id < an_adjacency.slots.size() ? an_adjacency.slots[_id] : adjacency::npos;
+        };
+
+        /// @brief Get the index of an activity through the event table
+        /// @param an_adjacency compiled adjacency of this network
+        /// @param an_activity activity object value
+        /// @return the activity index, npos if the activity is not in the network
+        index locate_activity(const adjacency& an_adjacency, const activity& an_activity) const
+        {
+            const index _trigger = locate(an_adjacency, an_activity.trigger_event());
+            const index _completion = locate(an_adjacency, an_activity.completion_event());
+            if (_trigger == adjacency::npos or _completion == adjacency::npos)
+                return adjacency::npos;
+            const auto _first = an_adjacency.completions.cbegin() + an_adjacency.out_begin(_trigger);
+            const auto _last = an_adjacency.completions.cbegin() + an_adjacency.out_end(_trigger);
+            const auto _search = std::lower_bound(_first, _last, _completion);
+            return _search != _last and *_search == _completion ? static_cast<index>(_search - an_adjacency.completions.cbegin()) : adjacency::npos;
+        };
+
+        /// @brief Get the index of a precedence constraint link through the event table
+        /// @param an_adjacency compiled adjacency of this network
+        /// @param a_link the link's source and target events
+        /// @return the link's edge index, npos if the link is not in the network
+        index locate_link(const adjacency& an_adjacency, const activity& a_link) const
+        {
+            const index _source = locate(an_adjacency, a_link.trigger_event());
+            const index _target = locate(an_adjacency, a_link.completion_event());
+            if (_source == adjacency::npos or _target == adjacency::npos or an_adjacency.out_edges.empty())
+                return adjacency::npos;
+            // see adjacency::link_index
+            const auto _first = an_adjacency.out_edges.cbegin() + an_adjacency.out_edge_begin(_source) + (an_adjacency.out_end(_source) - an_adjacency.out_begin(_source));
+            const auto _last = an_adjacency.out_edges.cbegin() + an_adjacency.out_edge_end(_source);
+            const auto _search = std::lower_bound(_first, _last, _target, [&an_adjacency](index l, index e) { return an_adjacency.completions[l] < e; });
+            return _search != _last and an_adjacency.completions[*_search] == _target ? *_search : adjacency::npos;
+        };
+
+        /// @brief Get the link of a precedence constraint: from the bound end of the predecessor to the successor's trigger event
+        static activity link_of(const activity& a_predecessor, const activity& a_successor, precedence a_relation)
+        {
+            const bool _from_finish = a_relation == precedence::finish_to_start or a_relation == precedence::finish_to_finish;
+            return activity(_from_finish ? a_predecessor.completion_event() : a_predecessor.trigger_event(), a_successor.trigger_event());
+        };
+
+        /// @brief Check whether a relation bounds the successor's finish, its link lag then depending on the successor's duration
+        static bool bounds_finish(precedence a_relation)
+        {
+            return a_relation == precedence::finish_to_finish or a_relation == precedence::start_to_finish;
+        };
+
+        /// @brief Get the index of an event that must be in the network
+        /// @param an_adjacency compiled adjacency of this network
+        /// @param an_event event id
+        /// @return the event index
+        index checked_index(const adjacency& an_adjacency, const event& an_event) const
+        {
+            const auto _index = locate(an_adjacency, an_event);
+            if (_index == adjacency::npos)
+                throw std::out_of_range("event is not in the network");
+            return _index;
+        };
+
+        /// @brief Compute the earliest and latest occurence of every event with one forward and one backward pass
+        /// @param an_adjacency compiled adjacency of this network
+        /// @return event times by event index
+        event_times compute_times(const adjacency& an_adjacency) const
+        {
+            if (not an_adjacency.acyclic())
+                throw std::logic_error("network contains a loop");
+
+            event_times _times(get_memory_resource());
+            _times.earliest.resize(an_adjacency.event_count());
+            _times.latest.resize(an_adjacency.event_count());
+
+            PERT_STATS(++stats().schedules;
+                       stats().events_visited += 2 * an_adjacency.event_count();
+                       stats().edges_visited += 2 * an_adjacency.triggers.size();)
+
+            // - forward pass: max earliest finish of incoming activities, initial events given by schedule
+            {
+                PERT_STATS(const phase_timer _timer(stats().forward_ns);)
+                for (const index e: an_adjacency.order)
+                    _times.earliest[e] = earliest_occurence(an_adjacency, _times, e);
+            }
+
+            // - backward pass: min latest start of outgoing activities, terminal events given by schedule
+            {
+                PERT_STATS(const phase_timer _timer(stats().backward_ns);)
+                for (auto it = an_adjacency.order.crbegin(); it != an_adjacency.order.crend(); ++it)
+                    _times.latest[*it] = latest_occurence(an_adjacency, _times, *it);
+            }
+
+            return _times;
+        };
+
+        /// @brief Compute the event times like compute_times, one topological level at a time on a thread pool.
+        ///        The events of a level only read the times of earlier levels (later levels backward) and each time
+        ///        comes from the same function as in the sequential passes, so the results are bitwise identical.
+        ///        Levels of at least __parallel_width events are split between the workers of the pool; runs of narrower
+        ///        levels are computed by the calling thread alone.
+        /// @param an_adjacency compiled adjacency of this network
+        /// @param a_pool thread pool running the wide levels
+        /// @return event times by event index
+        event_times compute_times(const adjacency& an_adjacency, thread_pool& a_pool) const
+        {
+            if (not an_adjacency.acyclic())
+                throw std::logic_error("network contains a loop");
+
+            // steps: a wide level shared by the workers, or a run of narrow levels
+            struct step
+            {
+                index first;
+                index last;
+                bool shared;
+            };
+            std::vector<step> _steps;
+            for (index l = 0; l < an_adjacency.level_count(); ++l)
+            {
+                const index _first = an_adjacency.levels[l];
+                const index _last = an_adjacency.levels[l + 1];
+                const bool _shared = _last - _first >= __parallel_width;
+                if (not _shared and not _steps.empty() and not _steps.back().shared)
+                    _steps.back().last = _last;
+                else
+                    _steps.push_back({ _first, _last, _shared });
+            }
+            if (a_pool.size() == 1 or std::none_of(_steps.cbegin(), _steps.cend(), [](const step& s) { return s.shared; }))
+                return compute_times(an_adjacency);
+
+            event_times _times(get_memory_resource());
+            _times.earliest.resize(an_adjacency.event_count());
+            _times.latest.resize(an_adjacency.event_count());
+
+            PERT_STATS(++stats().schedules;
+                       stats().events_visited += 2 * an_adjacency.event_count();
+                       stats().edges_visited += 2 * an_adjacency.triggers.size();)
+
+            // a shared step is cut into one slice per worker; parallel_for returns once every slice is done
+            const std::size_t _slices = a_pool.size();
+            const auto _run = [&](const step& s, const auto& a_pass)
+            {
+                if (not s.shared)
+                    a_pass(s.first, s.last);
+                else
+                    a_pool.parallel_for(_slices, [&](std::size_t t)
+                    {
+                        a_pass(static_cast<index>(s.first + (s.last - s.first) * t / _slices), static_cast<index>(s.first + (s.last - s.first) * (t + 1) / _slices));
+                    });
+            };
+
+            // - forward pass, first level first
+            {
+                PERT_STATS(const phase_timer _timer(stats().forward_ns);)
+                for (const step& s: _steps)
+                    _run(s, [&](index a_first, index a_last)
+                    {
+                        for (index i = a_first; i < a_last; ++i)
+                            _times.earliest[an_adjacency.order[i]] = earliest_occurence(an_adjacency, _times, an_adjacency.order[i]);
+                    });
+            }
+
+            // - backward pass, last level first
             {
-                if (_trigger_events.find(e) == _trigger_events.end())
-                    _terminal_events.emplace(e);
+                PERT_STATS(const phase_timer _timer(stats().backward_ns);)
+                for (auto it = _steps.crbegin(); it != _steps.crend(); ++it)
+                    _run(*it, [&](index a_first, index a_last)
+                    {
+                        for (index i = a_last; i-- > a_first; )
+                            _times.latest[an_adjacency.order[i]] = latest_occurence(an_adjacency, _times, an_adjacency.order[i]);
+                    });
             }
-            return _terminal_events;
-        };
 
+            return _times;
+        };
 
-        // schedule
-        //---------------------
+        /// @brief Narrowest level split between the threads of a level-synchronous pass
+        static constexpr std::size_t __parallel_width = 2048;
 
-        /// @brief Set net earliest start time and latest finish time.
-        ///        A network should be properly scheduled before it can be simulated
-        /// @param an_initial_time an initial time
-        /// @param a_terminal_time a terminal time
-        void schedule(const duration& an_initial_time, const duration& a_terminal_time)
+        /// @brief Check whether an edge (activity or link) sets the earliest occurence of its completion event
+        static bool tight(const adjacency& an_adjacency, const event_times& some_times, index an_edge)
         {
-            __initial_time = an_initial_time;
-            __terminal_time = a_terminal_time;
+            return some_times.earliest[an_adjacency.triggers[an_edge]] + an_adjacency.durations[an_edge] == some_times.earliest[an_adjacency.completions[an_edge]];
         };
 
-        /// @brief Get the network scheduled earliest start time
-        /// @return an initial duration value
-        duration initial_time() const
+        /// @brief Segment of an edge: an activity, or a link between its events with its lag as duration
+        static segment edge_segment(const adjacency& an_adjacency, index an_edge)
         {
-            return __initial_time;
+            if (not an_adjacency.is_link(an_edge))
+                return segment(an_adjacency.activities[an_edge], an_adjacency.durations[an_edge]);
+            return segment(activity(an_adjacency.events[an_adjacency.triggers[an_edge]], an_adjacency.events[an_adjacency.completions[an_edge]]), an_adjacency.durations[an_edge]);
         };
 
-        /// @brief Get the network scheduled earliest start time
-        /// @return a terminal duration value
-        duration terminal_time() const
-        {
-            return __terminal_time;
-        };
-        
-        /// @brief Get the slack of an activity
-        /// @param an_activity activity object value which slack is computed
-        /// @return slack (duration) of the activity
-        duration activity_float(const activity& an_activity) const
+        /// @brief Terminal events occuring last, in index order
+        static std::pmr::vector<index> critical_terminal_events(const adjacency& an_adjacency, const event_times& some_times)
         {
-            return earliest_occurence(an_activity.completion_event()) - earliest_finish(an_activity);
+            std::pmr::vector<index> _events(an_adjacency.terminal.get_allocator());
+            for (const index e: an_adjacency.terminal)
+            {
+                if (not _events.empty() and some_times.earliest[_events.front()] < some_times.earliest[e])
+                    _events.clear();
+                if (_events.empty() or not (some_times.earliest[e] < some_times.earliest[_events.front()]))
+                    _events.push_back(e);
+            }
+            return _events;
         };
 
-        /// @brief Get the free float of an activity
-        /// @param an_activity activity object value which slack is computed
-        /// @return free float (duration) of the activity
-        duration free_float(const activity& an_activity) const
+        /// @brief Earliest occurence of an event from the earliest occurences of its predecessors
+        duration earliest_occurence(const adjacency& an_adjacency, const event_times& some_times, index an_event) const
         {
-            return latest_occurence(an_activity.completion_event()) - earliest_finish(an_activity);
+            const index* _first = an_adjacency.in_begin(an_event);
+            const index* _last = an_adjacency.in_end(an_event);
+            if (_first == _last)
+                return __initial_time;
+
+            // links come after activities: constraints never move an event before the initial time.
+            // The floor is picked from a table, a branch on mixed networks costs more than the whole event.
+            const duration _floors[2] = { std::numeric_limits<duration>::lowest(), __initial_time };
+            duration _earliest = std::max(some_times.earliest[an_adjacency.triggers[*_first]] + an_adjacency.durations[*_first], _floors[an_adjacency.is_link(_last[-1])]);
+            for (++_first; _first != _last; ++_first)
+                _earliest = std::max(_earliest, some_times.earliest[an_adjacency.triggers[*_first]] + an_adjacency.durations[*_first]);
+            return _earliest;
         };
 
-        /// @brief Get the interfering float of an activity
-        /// @param an_activity id of the activity which interfering float is computed
-        /// @return interfering float (duration) of the activity
-        duration interfering_float(const activity& an_activity) const
+        /// @brief Latest occurence of an event from the latest occurences of its successors
+        duration latest_occurence(const adjacency& an_adjacency, const event_times& some_times, index an_event) const
         {
-            return std::max(0, earliest_occurence(an_activity.completion_event()) - latest_occurence(an_activity.trigger_event()) - estimated_duration(an_activity));
+            index _first = an_adjacency.out_edge_begin(an_event);
+            const index _last = an_adjacency.out_edge_end(an_event);
+            if (_first == _last)
+                return __terminal_time;
+
+            // without links, slots are activity indices
+            const auto _latest_through = [&](const auto& an_edge)
+            {
+                duration _latest = some_times.latest[an_adjacency.completions[an_edge(_first)]] - an_adjacency.durations[an_edge(_first)];
+                for (index k = _first + 1; k != _last; ++k)
+                    _latest = std::min(_latest, some_times.latest[an_adjacency.completions[an_edge(k)]] - an_adjacency.durations[an_edge(k)]);
+                return _latest;
+            };
+            if (an_adjacency.out_edges.empty())
+                return _latest_through([](index k) { return k; });
+
+            // links come after activities: constraints never move an event after the terminal time
+            const duration _ceilings[2] = { std::numeric_limits<duration>::max(), __terminal_time };
+            return std::min(_latest_through([&](index k) { return an_adjacency.out_edges[k]; }), _ceilings[an_adjacency.is_link(an_adjacency.out_edges[_last - 1])]);
         };
 
-        /// @brief Get the independent float of an activity
-        /// @param an_activity id of the activity which independent float is computed
-        /// @return independent float of the activity
-        duration independent_float(const activity& an_activity) const
+        /// @brief Reschedule the earliest occurences downstream of some events, in topological order.
+        ///        Propagation stops at events which earliest occurence does not change.
+        /// @param first_event first of the events which incoming activities changed
+        /// @param last_event past-the-end of the events which incoming activities changed
+        /// @param forced_count the first forced_count events are propagated even if their time does not change (new events)
+        void propagate_earliest(const index* first_event, const index* last_event, std::size_t forced_count)
         {
-            return free_float(an_activity) - activity_float(an_activity);
+            PERT_STATS(++stats().incremental_updates; const phase_timer _timer(stats().forward_ns);)
+            const adjacency& _adjacency = *__adjacency;
+            event_times& _times = *__times;
+            // min-heap on topological rank
+            const auto _later = [&_adjacency](index e1, index e2) { return _adjacency.rank[e1] > _adjacency.rank[e2]; };
+            std::pmr::vector<index>& _heap = __scratch_heap;
+            __scratch_queued.resize(_adjacency.event_count(), 0);
+            _heap.clear();
+            for (const index* e = first_event; e != last_event; ++e)
+                enqueue(*e, static_cast<std::size_t>(e - first_event) < forced_count, _heap, _later);
+
+            while (not _heap.empty())
+            {
+                std::pop_heap(_heap.begin(), _heap.end(), _later);
+                const index e = _heap.back();
+                _heap.pop_back();
+                PERT_STATS(++stats().events_visited;)
+                const bool _forced = __scratch_queued[e] == 2;
+                __scratch_queued[e] = 0;
+
+                const duration _earliest = earliest_occurence(_adjacency, _times, e);
+                if (not _forced and not (_earliest < _times.earliest[e] or _times.earliest[e] < _earliest))
+                    continue;
+                _times.earliest[e] = _earliest;
+
+                if (__tracking)
+                    record_event(e);
+                PERT_STATS(stats().edges_visited += _adjacency.out_edge_end(e) - _adjacency.out_edge_begin(e);)
+                for (index k = _adjacency.out_edge_begin(e); k != _adjacency.out_edge_end(e); ++k)
+                {
+                    const index a = _adjacency.out_edge(k);
+                    if (__tracking and not _adjacency.is_link(a))
+                        record_activity(a);
+                    enqueue(_adjacency.completions[a], false, _heap, _later);
+                }
+            }
         };
 
-        // - forward pass
-        
-        /// @brief Get the earliest occurence of an event
-        /// @param an_event event id
-        /// @return earliest occurence date
-        duration earliest_occurence(const event& an_event) const
+        /// @brief Reschedule the latest occurences upstream of some events, in reverse topological order.
+        ///        Propagation stops at events which latest occurence does not change.
+        /// @param first_event first of the events which outgoing activities changed
+        /// @param last_event past-the-end of the events which outgoing activities changed
+        /// @param forced_count the first forced_count events are propagated even if their time does not change (new events)
+        void propagate_latest(const index* first_event, const index* last_event, std::size_t forced_count)
         {
-            // initial event's occurence time is given by schedule
-            event _initial_event = *initial_events().begin();
-            if (an_event == _initial_event) 
-                return __initial_time;
-
-            // max earliest finish of incoming activities
-            std::set<activity> _incoming_activities = incoming_activities(an_event);
-            std::list<duration> _earliest_finish_times;
-            for (const auto& a: _incoming_activities)
+            PERT_STATS(++stats().incremental_updates; const phase_timer _timer(stats().backward_ns);)
+            const adjacency& _adjacency = *__adjacency;
+            event_times& _times = *__times;
+            // max-heap on topological rank
+            const auto _earlier = [&_adjacency](index e1, index e2) { return _adjacency.rank[e1] < _adjacency.rank[e2]; };
+            std::pmr::vector<index>& _heap = __scratch_heap;
+            __scratch_queued.resize(_adjacency.event_count(), 0);
+            _heap.clear();
+            for (const index* e = first_event; e != last_event; ++e)
+                enqueue(*e, static_cast<std::size_t>(e - first_event) < forced_count, _heap, _earlier);
+
+            while (not _heap.empty())
             {
-                _earliest_finish_times.push_back(earliest_finish(a));
+                std::pop_heap(_heap.begin(), _heap.end(), _earlier);
+                const index e = _heap.back();
+                _heap.pop_back();
+                PERT_STATS(++stats().events_visited;)
+                const bool _forced = __scratch_queued[e] == 2;
+                __scratch_queued[e] = 0;
+
+                const duration _latest = latest_occurence(_adjacency, _times, e);
+                if (not _forced and not (_latest < _times.latest[e] or _times.latest[e] < _latest))
+                    continue;
+                _times.latest[e] = _latest;
+
+                if (__tracking)
+                    record_event(e);
+                PERT_STATS(stats().edges_visited += _adjacency.in_end(e) - _adjacency.in_begin(e);)
+                for (const index* a = _adjacency.in_begin(e); a != _adjacency.in_end(e); ++a)
+                {
+                    if (__tracking and not _adjacency.is_link(*a))
+                        record_activity(*a);
+                    enqueue(_adjacency.triggers[*a], false, _heap, _earlier);
+                }
             }
-            return *std::max_element(_earliest_finish_times.begin(), _earliest_finish_times.end());
         };
-        
-        /// @brief Get the earliest finish date of an activity
-        /// @param an_activity activity object value which earliest finish date is to be computed
-        /// @return earliest finish date of the parameter activity
-        duration earliest_finish(const activity& an_activity) const
+
+        /// @brief Push an event on a propagation heap unless it is already queued
+        template<typename Compare>
+        void enqueue(index an_event, bool forced, std::pmr::vector<index>& a_heap, const Compare& a_compare)
         {
-            // earliest occurence of trigger + estimated duration
-            return earliest_occurence(an_activity.trigger_event()) + estimated_duration(an_activity);
+            if (__scratch_queued[an_event] == 0)
+            {
+                a_heap.push_back(an_event);
+                std::push_heap(a_heap.begin(), a_heap.end(), a_compare);
+            }
+            __scratch_queued[an_event] = std::max<char>(__scratch_queued[an_event], forced ? 2 : 1);
         };
 
-        // - backward pass
-        
-        /// @brief Get the latest occurence date of an event
-        /// @param an_event event id
-        /// @return latest occurence date of the parameter event
-        duration latest_occurence(const event& an_event) const
+        /// @brief Rebuild the snapshot after an activity was inserted or deleted, and reschedule only what moved.
+        ///        Times of events present before and after the edit are carried over, then propagated from the activity's ends and from new events.
+        /// @param an_activity the inserted or deleted activity
+        /// @param is_link true if the edit inserted or deleted a precedence constraint link between the activity's events
+        void reschedule_topology(const activity& an_activity, bool is_link = false)
         {
-            // terminal event's occurence time is given by schedule
-            event _terminal_event = *terminal_events().begin();
-            if (an_event == _terminal_event)
+            if (not __times)
             {
-                return __terminal_time;
+                invalidate();
+                return;
+            }
+
+            flush_changes();
+            const adjacency _old_adjacency = std::move(*__adjacency);
+            const event_times _old_times = std::move(*__times);
+            const adjacency& _adjacency = __adjacency.emplace(compile());
+            __scratch_queued.assign(_adjacency.event_count(), 0);
+            if (not _adjacency.acyclic())
+            {
+                __times.reset();
+                return;
+            }
+
+            // carry times over, matching events of both snapshots by interned id
+            event_times& _times = __times.emplace(get_memory_resource());
+            _times.earliest.resize(_adjacency.event_count(), __initial_time);
+            _times.latest.resize(_adjacency.event_count(), __terminal_time);
+            std::pmr::vector<index> _seeds(get_memory_resource());
+            for (index i = 0; i < _adjacency.event_count(); ++i)
+            {
+                const event_id _id = _adjacency.ids[i];
+                const index j = _id < _old_adjacency.slots.size() ? _old_adjacency.slots[_id] : adjacency::npos;
+                if (j == adjacency::npos)
+                {
+                    _seeds.push_back(i);
+                    continue;
+                }
+                _times.earliest[i] = _old_times.earliest[j];
+                _times.latest[i] = _old_times.latest[j];
+            }
+            if (__tracking)
+            {
+                for (index j = 0; j < _old_adjacency.event_count(); ++j)
+                    if (_adjacency.slots[_old_adjacency.ids[j]] == adjacency::npos)
+                        __changes.events.push_back(_old_adjacency.events[j]);
             }
 
-            // min latest start of outgoing activities
-            std::set<activity> _outgoing_activities = outgoing_activities(an_event);
-            std::list<duration> _latest_start_times;
-            for (const auto& a: _outgoing_activities)
+            const std::size_t _forced_count = _seeds.size();
+            if (__tracking)
             {
-                _latest_start_times.push_back(latest_start(a));
+                if (not is_link)
+                    __changes.activities.push_back(an_activity);
+                for (const index e: _seeds)
+                    record_event(e);
             }
-            return *std::min_element(_latest_start_times.begin(), _latest_start_times.end());
+
+            _seeds.push_back(locate(_adjacency, an_activity.completion_event()));
+            if (_seeds.back() == adjacency::npos)
+                _seeds.pop_back();
+            propagate_earliest(_seeds.data(), _seeds.data() + _seeds.size(), _forced_count);
+
+            _seeds.resize(_forced_count);
+            _seeds.push_back(locate(_adjacency, an_activity.trigger_event()));
+            if (_seeds.back() == adjacency::npos)
+                _seeds.pop_back();
+            propagate_latest(_seeds.data(), _seeds.data() + _seeds.size(), _forced_count);
         };
-        
-        /// @brief Get the latest start of an activity
-        /// @param an_activity activity object value which latest start date is to be computed
-        /// @return latest start date of parameter activity
-        duration latest_start(const activity& an_activity) const
+
+        /// @brief Drop the compiled snapshot and the cached event times after a topology change
+        void invalidate()
         {
-            // latest occurence of completion - estimated duration
-            return latest_occurence(an_activity.completion_event()) - estimated_duration(an_activity);
+            flush_changes();
+            __adjacency.reset();
+            __times.reset();
         };
 
-        // critical path
-        //---------------------
-
-        /// @brief Find the critical path of the network
-        /// @return list of activity segments ordered by precedence
-        std::vector<segment> find_critical_path() const
+        /// @brief Record an event which times moved (by index of the current snapshot)
+        void record_event(index an_event)
         {
-            // Copy this network
-            network a_network = *this;
-            // Tight schedule
-            a_network.schedule(0, 1);
-            a_network.schedule(0, a_network.earliest_occurence(*terminal_events().begin()));
-            // Take activities with no free float
-            std::vector<segment> _critical_path;
-            std::copy_if(__data.cbegin(), __data.cend(), std::inserter(_critical_path, _critical_path.end()), [a_network](const auto& segment)
+            __event_marks.resize(__adjacency->event_count(), 0);
+            if (__event_marks[an_event] == 0)
             {
-                return a_network.free_float(segment.first) == 0; 
-            });
-            std::sort(_critical_path.begin(), _critical_path.end(), [](const auto& s1, const auto& s2){ return s1.first < s2.first; });
-            return _critical_path;
+                __event_marks[an_event] = 1;
+                __pending_events.push_back(an_event);
+            }
         };
 
-        /// @brief Get displayable string of an activity segment
-        /// @param a_segment the segment object to be stringified
-        /// @return a string representing the activity segment
-        static std::string to_str(const segment& a_segment)
+        /// @brief Record an activity which times moved (by index of the current snapshot)
+        void record_activity(index an_activity)
         {
-            std::stringstream str_stream; 
-            str_stream << "[" << a_segment.first.trigger_event() << "]" << " --=" << a_segment.second << "=--> " << "[" << a_segment.first.completion_event() << "]";
-            return str_stream.str();
-        }
+            __activity_marks.resize(__adjacency->activity_count(), 0);
+            if (__activity_marks[an_activity] == 0)
+            {
+                __activity_marks[an_activity] = 1;
+                __pending_activities.push_back(an_activity);
+            }
+        };
 
-        /// @brief Get list of paths between two events
-        /// @param a_start_event the start event of the paths
-        /// @param a_finish_event the finish event of the paths
-        /// @return a list of paths from a_start_event to a_finish_event
-        std::vector<path> paths(const event& a_start_event, const event& a_finish_event)
+        /// @brief Translate recorded indices into event and activity values, before the snapshot they refer to goes away
+        void flush_changes() const
         {
-            return paths(path({}), a_start_event, a_finish_event);
-        }
+            if (not __adjacency or (__pending_events.empty() and __pending_activities.empty()))
+                return;
+            for (const index e: __pending_events)
+            {
+                __changes.events.push_back(__adjacency->events[e]);
+                __event_marks[e] = 0;
+            }
+            for (const index a: __pending_activities)
+            {
+                __changes.activities.push_back(__adjacency->activities[a]);
+                __activity_marks[a] = 0;
+            }
+            __pending_events.clear();
+            __pending_activities.clear();
+            std::sort(__changes.events.begin(), __changes.events.end());
+            __changes.events.erase(std::unique(__changes.events.begin(), __changes.events.end()), __changes.events.end());
+            std::sort(__changes.activities.begin(), __changes.activities.end());
+            __changes.activities.erase(std::unique(__changes.activities.begin(), __changes.activities.end()), __changes.activities.end());
+        };
 
-        /// @brief Assuming a partial path has already been found up until a current event, list eventual paths starting with the partial path and leading to a finish event.
-        /// @param a_partial_path path already browsed up to the current event
-        /// @param the_current_event the completion event of the partial path's last activity segment
-        /// @param a_finish_event the finish event aimed by the partial path
-        /// @return the list of paths from the current event to the finish event prepended with the partial path
-        std::vector<path> paths(const path a_partial_path, const event& the_current_event, const event& a_finish_event) const
+        /// @brief Label the strongly connected components of the events left out of the topological order (iterative Tarjan)
+        /// @param an_adjacency compiled adjacency of this network
+        /// @return component label by event index, npos for events in the topological order
+        static std::vector<index> strong_components(const adjacency& an_adjacency)
         {
-            // TODO: check that the current event is the last segment's completion event
-
-            std::vector<path> _paths;
-
-            for (const auto& a: outgoing_activities(the_current_event))
+            const std::size_t _event_count = an_adjacency.event_count();
+            std::vector<index> _components(_event_count, adjacency::npos);
+            std::vector<index> _discovery(_event_count, adjacency::npos);
+            std::vector<index> _low(_event_count, 0);
+            std::vector<bool> _on_stack(_event_count, false);
+            std::vector<index> _stack;
+            std::vector<std::pair<index, index>> _calls;    // (event, next outgoing edge slot)
+            index _time = 0, _count = 0;
+
+            for (index r = 0; r < _event_count; ++r)
             {
-                segment next_segment = std::make_pair(a, estimated_duration(a));
-                
-                // next segment creates loop
-                bool next_segment_creates_loop = false;
-                for (const auto& s: a_partial_path)
+                if (an_adjacency.rank[r] != adjacency::npos or _discovery[r] != adjacency::npos)
+                    continue;
+
+                _calls.emplace_back(r, an_adjacency.out_edge_begin(r));
+                _discovery[r] = _low[r] = _time++;
+                _stack.push_back(r);
+                _on_stack[r] = true;
+                while (not _calls.empty())
                 {
-                    if (next_segment.first.completion_event() == s.first.trigger_event())
+                    auto& [e, a] = _calls.back();
+                    if (a != an_adjacency.out_edge_end(e))
                     {
-                        //std::cout << next_segment.first.completion_event() << "==" << s.first.trigger_event() << std::endl;
-                        next_segment_creates_loop = true;
-                        break;
+                        const index _next = an_adjacency.completions[an_adjacency.out_edge(a)];
+                        ++a;
+                        if (an_adjacency.rank[_next] != adjacency::npos)
+                            continue;
+                        if (_discovery[_next] == adjacency::npos)
+                        {
+                            _discovery[_next] = _low[_next] = _time++;
+                            _stack.push_back(_next);
+                            _on_stack[_next] = true;
+                            _calls.emplace_back(_next, an_adjacency.out_edge_begin(_next));
+                        }
+                        else if (_on_stack[_next])
+                            _low[e] = std::min(_low[e], _discovery[_next]);
+                        continue;
                     }
-                }
-                if (next_segment_creates_loop)
-                {
-                    continue;
-                }
 
-                // next segment leads to finish event
-                if (next_segment.first.completion_event() == a_finish_event)
-                {
-                    path complete_path { a_partial_path };
-                    complete_path.push_back(next_segment);
-                    _paths.push_back(complete_path);
-                    return _paths;
+                    // e is done: pop its component if it is a root
+                    const index _done = e;
+                    _calls.pop_back();
+                    if (not _calls.empty())
+                        _low[_calls.back().first] = std::min(_low[_calls.back().first], _low[_done]);
+                    if (_low[_done] != _discovery[_done])
+                        continue;
+                    index _member;
+                    do
+                    {
+                        _member = _stack.back();
+                        _stack.pop_back();
+                        _on_stack[_member] = false;
+                        _components[_member] = _count;
+                    } while (_member != _done);
+                    ++_count;
                 }
+            }
+            return _components;
+        };
 
-                // next segment stacks on the partial path
-                path next_partial_path { a_partial_path };
-                next_partial_path.push_back(next_segment);
-                std::vector<path> paths_through = paths(next_partial_path, next_segment.first.completion_event(), a_finish_event);
-                for (const auto& p: paths_through)
+        /// @brief Find a cycle through an event inside its strongly connected component (breadth first, so the cycle is short)
+        /// @param an_adjacency compiled adjacency of this network
+        /// @param some_components component labels by event index
+        /// @param a_root the event the cycle starts and ends on
+        /// @param some_parents scratch buffer of npos values, restored on return
+        /// @return the cycle as a path
+        static path witness_loop(const adjacency& an_adjacency, const std::vector<index>& some_components, index a_root, std::vector<index>& some_parents)
+        {
+            // some_parents holds the edge (activity or link) reaching each visited event
+            std::vector<index> _queue { a_root };
+            index _closing = adjacency::npos;
+            const auto _visit = [&](index an_edge)
+            {
+                const index _next = an_adjacency.completions[an_edge];
+                if (_next == a_root)
+                    _closing = an_edge;
+                else if (some_components[_next] == some_components[a_root] and some_parents[_next] == adjacency::npos)
                 {
-                    _paths.push_back(p);
+                    some_parents[_next] = an_edge;
+                    _queue.push_back(_next);
                 }
+                return _closing != adjacency::npos;
+            };
+            for (std::size_t i = 0; i < _queue.size() and _closing == adjacency::npos; ++i)
+            {
+                const index e = _queue[i];
+                bool _closed = false;
+                for (index k = an_adjacency.out_edge_begin(e); k != an_adjacency.out_edge_end(e) and not _closed; ++k)
+                    _closed = _visit(an_adjacency.out_edge(k));
             }
 
-            return _paths;
+            path _loop;
+            for (index a = _closing; ; a = some_parents[an_adjacency.triggers[a]])
+            {
+                _loop.push_back(edge_segment(an_adjacency, a));
+                if (an_adjacency.triggers[a] == a_root)
+                    break;
+            }
+            std::reverse(_loop.begin(), _loop.end());
+            for (const index e: _queue)
+                some_parents[e] = adjacency::npos;
+            return _loop;
         };
 
-        /// @brief Get the list of loops in between two events of the network
-        /// @param a_start_event the start event 
-        /// @param a_finish_event the finish event
-        /// @return list of loop paths found in between two events
-        std::vector<path> loop_paths(const event& a_start_event, const event& a_finish_event) const
+        /// @brief Flag the trigger events of a partial path
+        static void mark_triggers(const adjacency& an_adjacency, const path& a_path, std::vector<bool>& some_flags)
         {
-            return loop_paths(path({}), a_start_event, a_finish_event);
-        }
+            for (const auto& s: a_path)
+            {
+                const auto e = an_adjacency.event_index(s.first.trigger_event());
+                if (e != adjacency::npos)
+                    some_flags[e] = true;
+            }
+        };
 
-        /// @brief Assuming a partial path has already been found up until a current event, list eventual loop paths starting with the partial path.
-        /// @param a_partial_path path already browsed up to the current event (has no loops and has not reach finish event)
-        /// @param the_current_event the completion event of the partial path's last activity segment 
-        /// @param a_finish_event the finish event of the loop paths search
-        /// @return list of loop paths in between the current event and the finish event
-        std::vector<path> loop_paths(const path& a_partial_path, const event& the_current_event, const event& a_finish_event) const
+        /// @brief Depth first search of the loops reachable from a current event before a finish event, on a shared stack
+        /// @return true if the search of the current branch stopped (loop found or finish event reached)
+        static bool collect_loop_paths(const adjacency& an_adjacency, path& a_stack, std::vector<bool>& on_stack, index the_current_event, index a_finish_event, std::vector<path>& some_paths)
         {
-            std::vector<path> _paths;
-
-            for (const auto& a: outgoing_activities(the_current_event))
+            PERT_STATS(++stats().events_visited; stats().edges_visited += an_adjacency.out_end(the_current_event) - an_adjacency.out_begin(the_current_event);)
+            bool _stopped = false;
+            // the current event becomes a trigger of every segment stacked below
+            on_stack[the_current_event] = true;
+            for (index a = an_adjacency.out_begin(the_current_event); a != an_adjacency.out_end(the_current_event) and not _stopped; ++a)
             {
-                segment next_segment = std::make_pair(a, estimated_duration(a));
-                
+                const index _next = an_adjacency.completions[a];
+
                 // next segment creates loop
-                for (const auto& s: a_partial_path)
+                if (on_stack[_next] and _next != the_current_event)
                 {
-                    if (next_segment.first.completion_event() == s.first.trigger_event())
-                    {
-                        path loop_path { a_partial_path };
-                        loop_path.push_back(next_segment);
-                        _paths.push_back(loop_path);
-                        return _paths;
-                    }
+                    a_stack.emplace_back(an_adjacency.activities[a], an_adjacency.durations[a]);
+                    some_paths.push_back(a_stack);
+                    a_stack.pop_back();
+                    _stopped = true;
                 }
-
                 // next segment leads to finish event
-                if (next_segment.first.completion_event() == a_finish_event)
+                else if (_next == a_finish_event)
                 {
-                    return _paths;
+                    _stopped = true;
                 }
-
                 // next segment stacks on the partial path
-                path next_partial_path { a_partial_path };
-                next_partial_path.push_back(next_segment);
-                std::vector<path> loop_paths_through = loop_paths(next_partial_path, next_segment.first.completion_event(), a_finish_event);
-                for (const auto& p: loop_paths_through)
+                else
                 {
-                    _paths.push_back(p);
+                    a_stack.emplace_back(an_adjacency.activities[a], an_adjacency.durations[a]);
+                    collect_loop_paths(an_adjacency, a_stack, on_stack, _next, a_finish_event, some_paths);
+                    a_stack.pop_back();
                 }
             }
-
-            return _paths;
+            on_stack[the_current_event] = false;
+            return _stopped;
         };
 
+        using event_id = typename event_table<event>::id;
 
-        // Constructors
-        //---------------------
+        /// @brief Key of an activity in the activity tables: its trigger and completion event ids
+        static std::uint64_t key(event_id a_trigger, event_id a_completion)
+        {
+            return static_cast<std::uint64_t>(a_trigger) << 32 | a_completion;
+        };
 
-        /// @brief Construct empty network
-        network() : __data({}) {};
+        static event_id trigger_id(std::uint64_t a_key) { return static_cast<event_id>(a_key >> 32); }
+        static event_id completion_id(std::uint64_t a_key) { return static_cast<event_id>(a_key); }
 
-        /// @brief Construct a network from a list of paths
-        /// @param some_paths list of paths to include in network
-        network(const std::vector<path>& some_paths) : network()
+        /// @brief Get the key of an activity, which matches no activity if one of its events was never interned
+        std::uint64_t find_key(const activity& an_activity) const
         {
-            for (const path& p: some_paths)
-            {
-                for (const segment& s: p)
-                {
-                    this->add_activity(s.first, s.second);
-                }
-            }
+            return key(__events.find(an_activity.trigger_event()), __events.find(an_activity.completion_event()));
         };
 
-        /// @brief Construct a network from a list of paths and a schedule
-        /// @param some_paths list of paths to include in network
-        /// @param a_start_time scheduled earliest start time of the network project
-        /// @param a_finish_time scheduled latest finish time of the network project
-        network(const std::vector<path>& some_paths, const duration& a_start_time, const duration& a_finish_time) : network(some_paths) 
+        /// @brief Get the key of an activity, interning its events
+        std::uint64_t intern_key(const activity& an_activity)
         {
-            __initial_time = a_start_time;
-            __terminal_time = a_finish_time;
+            const event_id _trigger = __events.intern(an_activity.trigger_event());
+            return key(_trigger, __events.intern(an_activity.completion_event()));
         };
-        
-        /// @brief Subset of network made of activities in between two events
-        /// @param a_start_event event id of the subnet's initial event
-        /// @param a_finish_event event id of the subnet's terminal event
-        /// @return a partial network
-        network subnet(const event& a_start_event, const event& a_finish_event)
+
+        /// @brief Get the activity of a key
+        activity to_activity(std::uint64_t a_key) const
         {
-            return network(paths(a_start_event, a_finish_event), earliest_occurence(a_start_event), latest_occurence(a_finish_event));
-        }
+            return activity(__events[trigger_id(a_key)], __events[completion_id(a_key)]);
+        };
 
-        // automation
-        //---------------------
-        
-        /// @brief create network object from a network description as string
-        /// @param txt string representation of network
-        /// @return network object
-        static network from_txt(const std::string& txt)
+        /// @brief A precedence constraint, stored under the key of its link
+        struct constraint
         {
-            network txt_network;
-            
-            // Split text into lines and lines into event event duration
-            std::string _line;
-            char delimiter = '\n';
-            std::stringstream txt_stream(txt);
-            // Get schedule times
-            duration _initial_time;
-            duration _terminal_time;
-            std::getline(txt_stream, _line, delimiter);
-            std::stringstream(_line) >> _initial_time;
-            std::getline(txt_stream, _line, delimiter);
-            std::stringstream(_line) >> _terminal_time;
-            txt_network.schedule(_initial_time, _terminal_time);
-            // Get activities
-            while (std::getline(txt_stream, _line, delimiter))
+            std::uint64_t predecessor;          ///< activity key
+            std::uint64_t successor;            ///< activity key
+            precedence relation;
+            duration lag;
+
+            bool binds(std::uint64_t a_predecessor, std::uint64_t a_successor, precedence a_relation) const
             {
-                event s, f;
-                duration d;
-                std::stringstream _line_stream(_line);
-                _line_stream >> s >> f >> d;
-                txt_network.add_activity(s, f, d);
-            }
+                return predecessor == a_predecessor and successor == a_successor and relation == a_relation;
+            };
+        };
 
-            return txt_network;
+        /// @brief Get the lag of a constraint's link: its lag, minus the successor's duration for a finish bound
+        duration link_lag(const constraint& a_constraint) const
+        {
+            if (not bounds_finish(a_constraint.relation))
+                return a_constraint.lag;
+            const auto _search = __data.find(a_constraint.successor);
+            return _search == __data.end() ? a_constraint.lag : a_constraint.lag - _search->second;
         };
-        
-    private:
 
-        /// @brief Get the trigger events of the network
-        /// @return a set of events
-        std::set<event> trigger_events() const
+        /// @brief Call a function on the key and the lag of every link, in no particular order.
+        ///        The lag of a link is the largest lag of its constraints; links from an event to itself without positive lag are left out.
+        template<typename Function>
+        void for_each_link(const Function& a_function) const
         {
-            std::set<event> _trigger_events;
-            for (auto& act: __data)
+            // constraints sharing a link are adjacent
+            for (auto it = __constraints.cbegin(); it != __constraints.cend(); )
             {
-                _trigger_events.emplace(act.first.trigger_event());
+                const std::uint64_t _key = it->first;
+                duration _lag = link_lag(it->second);
+                for (++it; it != __constraints.cend() and it->first == _key; ++it)
+                    _lag = std::max(_lag, link_lag(it->second));
+                if (trigger_id(_key) != completion_id(_key) or duration(0) < _lag)
+                    a_function(_key, _lag);
             }
-            return _trigger_events;
         };
 
-        /// @brief Get the completion events of the network
-        /// @return a set of events
-        std::set<event> completion_events() const
+        /// @brief Get the lag of a link from its constraints (see for_each_link)
+        duration link_lag(std::uint64_t a_key) const
         {
-            std::set<event> _completion_events;
-            for (auto& act: __data)
-            {
-                _completion_events.emplace(act.first.completion_event());
-            }
-            return _completion_events;
+            const auto [_first, _last] = __constraints.equal_range(a_key);
+            duration _lag = link_lag(_first->second);
+            for (auto it = _first; it != _last; ++it)
+                _lag = std::max(_lag, link_lag(it->second));
+            return _lag;
         };
 
-        /// @brief Get the activities that lead to a certain event
-        /// @param an_event the event which predecessor activities are returned
-        /// @return a set of activity objects
-        std::set<activity> incoming_activities(const event& an_event) const
+        /// @brief Bring the snapshot and the cached times up to date after the constraints of a link changed
+        /// @param a_key link key
+        /// @param is_added_or_deleted true if the link appeared or disappeared with the change
+        /// @param is_recompiled true if the snapshot was just rebuilt, with the link's lag but times carried over
+        void update_link(std::uint64_t a_key, bool is_added_or_deleted, bool is_recompiled = false)
         {
-            auto _activities = activities();
-            std::set<activity> _incoming_activities;
-            std::copy_if(_activities.cbegin(), _activities.cend(), std::inserter(_incoming_activities, _incoming_activities.end()), [an_event](const activity& a)
+            // links from an event to itself come and go with the sign of their lag
+            if (is_added_or_deleted or trigger_id(a_key) == completion_id(a_key))
             {
-                return a.precedes(an_event); 
-            });
-            return _incoming_activities;
+                reschedule_topology(to_activity(a_key), true);
+                return;
+            }
+
+            // topology is unchanged: patch the compiled snapshot in place
+            if (not __adjacency)
+                return;
+            const duration _lag = link_lag(a_key);
+            const index _index = locate_link(*__adjacency, to_activity(a_key));
+            if (__adjacency->durations[_index] == _lag and not is_recompiled)
+                return;
+            __adjacency->durations[_index] = _lag;
+            if (not __times)
+                return;
+            propagate_earliest(&__adjacency->completions[_index], &__adjacency->completions[_index] + 1, 0);
+            propagate_latest(&__adjacency->triggers[_index], &__adjacency->triggers[_index] + 1, 0);
         };
 
-        /// @brief Get the activities preceded by a certain event
-        /// @param an_event the event which next activities are returned
-        /// @return a set of activity objects
-        std::set<activity> outgoing_activities(const event& an_event) const
+        /// @brief Update the links of the finish bounds of an activity after its duration changed
+        /// @param an_activity activity key
+        /// @param is_recompiled true if the activity was added or deleted, the snapshot being rebuilt
+        void update_finish_bounds(std::uint64_t an_activity, bool is_recompiled)
         {
-            auto _activities = activities();
-            std::set<activity> _outgoing_activities;
-            std::copy_if(_activities.cbegin(), _activities.cend(), std::inserter(_outgoing_activities, _outgoing_activities.end()), [an_event](const activity& a)
-            {
-                return a.follows(an_event); 
-            });
-            return _outgoing_activities;
+            const auto [_first, _last] = __finish_bounds.equal_range(an_activity);
+            for (auto it = _first; it != _last; ++it)
+                update_link(it->second, false, is_recompiled);
         };
 
     // data members
     private:
-        std::map<activity, duration> __data;
+        event_table<event> __events;
+        std::pmr::unordered_map<std::uint64_t, duration> __data;         ///< activity key -> duration
+        std::pmr::unordered_map<std::uint64_t, estimate> __estimates;    ///< activity key -> three point estimate
+        std::pmr::unordered_map<std::uint64_t, crash> __crashes;         ///< activity key -> crash option
+        std::pmr::unordered_multimap<std::uint64_t, constraint> __constraints;   ///< link key -> precedence constraints sharing the link
+        std::pmr::unordered_multimap<std::uint64_t, std::uint64_t> __finish_bounds; ///< activity key -> link keys of the finish bounds of the activity
         duration __initial_time;
         duration __terminal_time;
+        mutable std::optional<adjacency> __adjacency;
+        mutable std::optional<event_times> __times;
+        bool __tracking = false;
+        mutable changes __changes;
+        mutable std::pmr::vector<index> __pending_events;
+        mutable std::pmr::vector<index> __pending_activities;
+        mutable std::pmr::vector<char> __event_marks;
+        mutable std::pmr::vector<char> __activity_marks;
+        std::pmr::vector<index> __scratch_heap;
+        std::pmr::vector<char> __scratch_queued;
         
     };
 
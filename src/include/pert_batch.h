@@ -0,0 +1,234 @@
+/***
+ * @brief This file describes a batched forward pass that schedules many duration samples of a network per traversal.
+ * @author Johann Fotsing
+ * @date 2026-10-16
+ * @file pert_batch.h
+ */
+
+#pragma once
+
+#include <pert.h>
+#include <type_traits>
+
+#if defined(__GNUC__) and (defined(__x86_64__) or defined(__i386__))
+#define PERT_BATCH_X86 1
+#endif
+
+namespace pert
+{
+
+    /// @brief Instruction sets the batched forward pass can run on
+    enum class instruction_set
+    {
+        scalar,
+        avx2,
+        avx512
+    };
+
+    /**
+     * @brief This class runs the forward pass of a network on a batch of duration samples at once.
+     * Durations and earliest occurences are stored in structure of arrays form: each activity (resp. event) owns
+     * Lanes consecutive values, one per sample, so that one traversal of the topology computes the max-plus
+     * forward pass of every sample with SIMD instructions. The instruction set is chosen at runtime.
+     *
+     * @tparam EventIDType type of the network's event objects
+     * @tparam DurationType type of the network's duration objects
+     * @tparam Lanes number of samples per batch
+     * @tparam ValueType type of the sampled durations and times
+     */
+    template<typename EventIDType, typename DurationType, std::size_t Lanes = 16, typename ValueType = DurationType>
+    class batch_forward_pass
+    {
+
+    public:
+
+        /// @brief context types
+        using network_type = network<EventIDType, DurationType>;
+        using adjacency = typename network_type::adjacency;
+        using index = typename adjacency::index;
+        using value = ValueType;
+        static constexpr std::size_t lanes = Lanes;
+
+    public:
+
+        /// @brief Prepare batched forward passes of a network, every lane starting with the network's estimated durations.
+        ///        The network must outlive this object and must not be modified while it is used.
+        /// @param a_network a network without loop
+        /// @param an_instruction_set instruction set to use, the best one supported by the processor by default
+        batch_forward_pass(const network_type& a_network, instruction_set an_instruction_set = best_instruction_set()) :
+            __adjacency(a_network.compiled()),
+            __initial_time(static_cast<value>(a_network.initial_time())),
+            __durations(a_network.compiled().activity_count() * Lanes),
+            __earliest(a_network.compiled().event_count() * Lanes),
+            __instruction_set(an_instruction_set)
+        {
+            if (not __adjacency.acyclic())
+                throw std::logic_error("network contains a loop");
+            if (__adjacency.link_count() > 0)
+                throw std::invalid_argument("batches do not support precedence constraints");
+            for (index a = 0; a < __adjacency.activity_count(); ++a)
+                std::fill_n(durations(a), Lanes, static_cast<value>(__adjacency.durations[a]));
+        };
+
+        /// @brief Get the best instruction set supported by the processor
+        static instruction_set best_instruction_set()
+        {
+#ifdef PERT_BATCH_X86
+            if constexpr (std::is_arithmetic_v<value>)
+            {
+                if (__builtin_cpu_supports("avx512f"))
+                    return instruction_set::avx512;
+                if (__builtin_cpu_supports("avx2"))
+                    return instruction_set::avx2;
+            }
+#endif
+            return instruction_set::scalar;
+        };
+
+        /// @brief Get the instruction set used by the forward pass
+        instruction_set used_instruction_set() const
+        {
+            return __instruction_set;
+        };
+
+        /// @brief Get the durations of an activity, one per lane
+        /// @param an_activity activity index in the network's compiled adjacency
+        /// @return pointer to Lanes values
+        value* durations(index an_activity)
+        {
+            return __durations.data() + an_activity * Lanes;
+        };
+
+        /// @brief Get the durations of an activity, one per lane
+        const value* durations(index an_activity) const
+        {
+            return __durations.data() + an_activity * Lanes;
+        };
+
+        /// @brief Get the earliest occurences of an event computed by the last run, one per lane
+        /// @param an_event event index in the network's compiled adjacency
+        /// @return pointer to Lanes values
+        const value* earliest(index an_event) const
+        {
+            return __earliest.data() + an_event * Lanes;
+        };
+
+        /// @brief Get the completion time of a lane: the latest earliest occurence of the terminal events
+        /// @param a_lane lane number
+        value completion(std::size_t a_lane) const
+        {
+            value _completion = __initial_time;
+            for (const index e: __adjacency.terminal)
+                _completion = std::max(_completion, earliest(e)[a_lane]);
+            return _completion;
+        };
+
+        /// @brief Run the forward pass of every lane
+        void run()
+        {
+#ifdef PERT_BATCH_X86
+            if constexpr (std::is_arithmetic_v<value>)
+            {
+                if (__instruction_set == instruction_set::avx512)
+                    return forward_avx512(__adjacency, __durations.data(), __earliest.data(), __initial_time);
+                if (__instruction_set == instruction_set::avx2)
+                    return forward_avx2(__adjacency, __durations.data(), __earliest.data(), __initial_time);
+            }
+#endif
+            forward_kernel<1>(__adjacency, __durations.data(), __earliest.data(), __initial_time);
+        };
+
+    private:
+
+        /// @brief Max-plus forward pass over all lanes, Width lanes per vector operation
+        template<std::size_t Width>
+        [[gnu::always_inline]] static inline void forward_kernel(const adjacency& an_adjacency, const value* some_durations, value* some_earliest, value an_initial_time)
+        {
+            if constexpr (Width == 1 or not std::is_arithmetic_v<value>)
+            {
+                for (const index e: an_adjacency.order)
+                {
+                    value* _earliest = some_earliest + e * Lanes;
+                    const index* _first = an_adjacency.in_begin(e);
+                    const index* _last = an_adjacency.in_end(e);
+                    if (_first == _last)
+                    {
+                        std::fill_n(_earliest, Lanes, an_initial_time);
+                        continue;
+                    }
+                    for (std::size_t l = 0; l < Lanes; ++l)
+                        _earliest[l] = some_earliest[an_adjacency.triggers[*_first] * Lanes + l] + some_durations[*_first * Lanes + l];
+                    for (++_first; _first != _last; ++_first)
+                    {
+                        const value* _trigger = some_earliest + an_adjacency.triggers[*_first] * Lanes;
+                        const value* _duration = some_durations + *_first * Lanes;
+                        for (std::size_t l = 0; l < Lanes; ++l)
+                            _earliest[l] = std::max(_earliest[l], _trigger[l] + _duration[l]);
+                    }
+                }
+            }
+            else
+            {
+                // the event's accumulators stay in registers while its incoming activities are scanned
+                typedef value vector __attribute__((vector_size(Width * sizeof(value)), aligned(alignof(value)), may_alias));
+                constexpr std::size_t _count = Lanes / Width;
+                static_assert(Lanes % Width == 0, "lanes must be a multiple of the vector width");
+                for (const index e: an_adjacency.order)
+                {
+                    value* _earliest = some_earliest + e * Lanes;
+                    const index* _first = an_adjacency.in_begin(e);
+                    const index* _last = an_adjacency.in_end(e);
+                    if (_first == _last)
+                    {
+                        std::fill_n(_earliest, Lanes, an_initial_time);
+                        continue;
+                    }
+                    vector _accumulators[_count];
+                    for (std::size_t c = 0; c < _count; ++c)
+                        _accumulators[c] = *reinterpret_cast<const vector*>(some_earliest + an_adjacency.triggers[*_first] * Lanes + c * Width)
+                            + *reinterpret_cast<const vector*>(some_durations + *_first * Lanes + c * Width);
+                    for (++_first; _first != _last; ++_first)
+                    {
+                        const value* _trigger = some_earliest + an_adjacency.triggers[*_first] * Lanes;
+                        const value* _duration = some_durations + *_first * Lanes;
+                        for (std::size_t c = 0; c < _count; ++c)
+                        {
+                            const vector _finish = *reinterpret_cast<const vector*>(_trigger + c * Width) + *reinterpret_cast<const vector*>(_duration + c * Width);
+                            _accumulators[c] = _accumulators[c] < _finish ? _finish : _accumulators[c];
+                        }
+                    }
+                    for (std::size_t c = 0; c < _count; ++c)
+                        *reinterpret_cast<vector*>(_earliest + c * Width) = _accumulators[c];
+                }
+            }
+        };
+
+#ifdef PERT_BATCH_X86
+        /// @brief Number of lanes per vector register of a given size, at most Lanes
+        static constexpr std::size_t width(std::size_t a_register_size)
+        {
+            return std::max<std::size_t>(1, std::min(Lanes, a_register_size / sizeof(value)));
+        };
+
+        [[gnu::target("avx512f")]] static void forward_avx512(const adjacency& an_adjacency, const value* some_durations, value* some_earliest, value an_initial_time)
+        {
+            forward_kernel<width(64)>(an_adjacency, some_durations, some_earliest, an_initial_time);
+        };
+
+        [[gnu::target("avx2")]] static void forward_avx2(const adjacency& an_adjacency, const value* some_durations, value* some_earliest, value an_initial_time)
+        {
+            forward_kernel<width(32)>(an_adjacency, some_durations, some_earliest, an_initial_time);
+        };
+#endif
+
+    // data members
+    private:
+        const adjacency& __adjacency;
+        value __initial_time;
+        std::vector<value> __durations;
+        std::vector<value> __earliest;
+        instruction_set __instruction_set;
+
+    };
+
+} // namespace pert
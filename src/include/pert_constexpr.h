@@ -0,0 +1,502 @@
+/***
+ * @brief This file describes fixed-capacity networks which can be built, validated and scheduled at compile time.
+ * @author Johann Fotsing
+ * @date 2026-10-16
+ * @file pert_constexpr.h
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+
+namespace pert
+{
+
+    /**
+     * @brief This class describes an activity network of at most Capacity activities, with the API of network
+     * for construction, validation, event times, floats and critical path, usable in constant expressions.
+     * Events and activities are kept sorted, like the compiled snapshot of a network, so indices, times and the ties of
+     * the critical path match those of a network with the same activities.
+     * Every change re-analyses the network (topological order, forward and backward passes) and stores the event
+     * times, so queries on an analysed network are table lookups. A loop makes the change throw std::logic_error:
+     * a compile error when the network is built in a constant expression, e.g.
+     *
+     *     constexpr auto a_template = fixed_network<int, int, 3>().add_activity(1, 2, 4).add_activity(2, 3, 1).schedule(0, 5);
+     *     static_assert(a_template.is_well_formed() and a_template.earliest_occurence(3) == 5);
+     *
+     * @tparam EventIDType type of the network's event objects, a literal type for compile time use
+     * @tparam DurationType type of the network's duration objects, a literal type for compile time use
+     * @tparam Capacity maximal number of activities
+     */
+    template<typename EventIDType, typename DurationType, std::size_t Capacity>
+    class fixed_network
+    {
+
+    public:
+
+        /// @brief context types
+        using event = EventIDType;
+        using duration = DurationType;
+        using index = std::size_t;
+        static constexpr index npos = static_cast<index>(-1);
+        static constexpr std::size_t capacity = Capacity;
+
+        /// @brief Activity linking a trigger event to a completion event
+        class activity
+        {
+
+        public:
+            constexpr activity() : __trigger_event(), __completion_event() {}
+            constexpr activity(event a_trigger_event, event a_completion_event) : __trigger_event(a_trigger_event), __completion_event(a_completion_event) {}
+            constexpr event trigger_event() const { return __trigger_event; }
+            constexpr event completion_event() const { return __completion_event; }
+            constexpr activity reverse() const { return activity(__completion_event, __trigger_event); }
+            constexpr bool operator<(const activity& a) const
+            {
+                if (__trigger_event == a.__trigger_event)
+                    return __completion_event < a.__completion_event;
+                return __trigger_event < a.__trigger_event;
+            };
+            constexpr bool operator==(const activity& a) const
+            {
+                return __trigger_event == a.__trigger_event and __completion_event == a.__completion_event;
+            };
+
+        private:
+            event __trigger_event;
+            event __completion_event;
+        };
+
+        /// @brief Activity and its duration
+        struct segment
+        {
+            activity first;
+            duration second;
+        };
+
+        /// @brief Chain of activity segments, ordered by precedence
+        struct path
+        {
+            std::array<segment, Capacity> segments {};
+            std::size_t count = 0;
+
+            constexpr std::size_t size() const { return count; }
+            constexpr bool empty() const { return count == 0; }
+            constexpr const segment& operator[](std::size_t i) const { return segments[i]; }
+            constexpr const segment* begin() const { return segments.data(); }
+            constexpr const segment* end() const { return segments.data() + count; }
+        };
+
+        /// @brief Dates and floats of every activity, indexed like activity(index)
+        struct float_report
+        {
+            std::array<duration, Capacity> earliest_start {};
+            std::array<duration, Capacity> earliest_finish {};
+            std::array<duration, Capacity> latest_start {};
+            std::array<duration, Capacity> latest_finish {};
+            std::array<duration, Capacity> activity_float {};
+            std::array<duration, Capacity> free_float {};
+            std::array<duration, Capacity> interfering_float {};
+            std::array<duration, Capacity> independent_float {};
+        };
+
+    public:
+
+        /// @brief Construct an empty network
+        constexpr fixed_network() = default;
+
+        /// @brief Construct a network from activity segments, analysed once
+        /// @param some_segments activities and their durations
+        /// @param an_initial_time scheduled earliest start time
+        /// @param a_terminal_time scheduled latest finish time
+        template<std::size_t Count>
+        constexpr fixed_network(const segment (&some_segments)[Count], const duration& an_initial_time, const duration& a_terminal_time) :
+            __initial_time(an_initial_time), __terminal_time(a_terminal_time)
+        {
+            for (const segment& s: some_segments)
+                insert(s.first, s.second);
+            analyse();
+        };
+
+        /// @brief Add an activity to the network, as network::add_activity: an activity already in the network, or
+        ///        which reverse is in the network, is left out
+        /// @return a reference to this network (for syntactic sugar)
+        /// @throw std::length_error if the network is full, std::logic_error if the activity closes a loop
+        constexpr fixed_network& add_activity(const event& a_trigger_event, const event& a_completion_event, const duration& a_duration)
+        {
+            return add_activity(activity(a_trigger_event, a_completion_event), a_duration);
+        };
+
+        /// @brief Add an activity to the network (see above)
+        constexpr fixed_network& add_activity(const activity& an_activity, const duration& a_duration)
+        {
+            if (insert(an_activity, a_duration))
+                analyse();
+            return *this;
+        };
+
+        /// @brief Set the estimated duration of an activity, adding the activity if it is not in the network
+        constexpr fixed_network& set_estimated_duration(const activity& an_activity, const duration& a_duration)
+        {
+            const index a = activity_index(an_activity);
+            if (a == npos)
+                return add_activity(an_activity, a_duration);
+            __durations[a] = a_duration;
+            analyse();
+            return *this;
+        };
+
+        /// @brief Set the network's earliest start time and latest finish time
+        /// @return a reference to this network (for syntactic sugar)
+        constexpr fixed_network& schedule(const duration& an_initial_time, const duration& a_terminal_time)
+        {
+            __initial_time = an_initial_time;
+            __terminal_time = a_terminal_time;
+            analyse();
+            return *this;
+        };
+
+        /// @brief Get the network scheduled earliest start time
+        constexpr duration initial_time() const { return __initial_time; }
+
+        /// @brief Get the network scheduled latest finish time
+        constexpr duration terminal_time() const { return __terminal_time; }
+
+        /// @brief Get the number of events
+        constexpr std::size_t event_count() const { return __event_count; }
+
+        /// @brief Get the number of activities
+        constexpr std::size_t activity_count() const { return __activity_count; }
+
+        /// @brief Get an event by index, events being sorted
+        constexpr event event_at(index an_event) const { return __events[an_event]; }
+
+        /// @brief Get an activity by index, activities being sorted
+        constexpr activity activity_at(index an_activity) const { return __activities[an_activity]; }
+
+        /// @brief Get the dense index of an event, npos if the event is not in the network
+        constexpr index event_index(const event& an_event) const
+        {
+            index _first = 0, _last = __event_count;
+            while (_first < _last)
+            {
+                const index _middle = _first + (_last - _first) / 2;
+                if (__events[_middle] < an_event)
+                    _first = _middle + 1;
+                else
+                    _last = _middle;
+            }
+            return _first < __event_count and __events[_first] == an_event ? _first : npos;
+        };
+
+        /// @brief Get the dense index of an activity, npos if the activity is not in the network
+        constexpr index activity_index(const activity& an_activity) const
+        {
+            const index _trigger = event_index(an_activity.trigger_event());
+            if (_trigger == npos)
+                return npos;
+            for (index a = __out_offsets[_trigger]; a != __out_offsets[_trigger + 1]; ++a)
+                if (__activities[a] == an_activity)
+                    return a;
+            return npos;
+        };
+
+        /// @brief Check whether an activity is in the network
+        constexpr bool contains(const activity& an_activity) const
+        {
+            return activity_index(an_activity) != npos;
+        };
+
+        /// @brief Get the estimated duration of an activity
+        /// @throw std::out_of_range if the activity is not in the network
+        constexpr duration estimated_duration(const activity& an_activity) const
+        {
+            return __durations[checked_activity(an_activity)];
+        };
+
+        /// @brief Get the number of initial events (events without incoming activity)
+        constexpr std::size_t initial_count() const { return __initial_count; }
+
+        /// @brief Get the number of terminal events (events without outgoing activity)
+        constexpr std::size_t terminal_count() const { return __terminal_count; }
+
+        /// @brief A network is well formed if it has exactly one initial and one terminal event (a loop cannot be built)
+        constexpr bool is_well_formed() const
+        {
+            return __initial_count == 1 and __terminal_count == 1;
+        };
+
+        /// @brief Get the earliest occurence of an event
+        /// @throw std::out_of_range if the event is not in the network
+        constexpr duration earliest_occurence(const event& an_event) const
+        {
+            return __earliest[checked_event(an_event)];
+        };
+
+        /// @brief Get the latest occurence of an event
+        /// @throw std::out_of_range if the event is not in the network
+        constexpr duration latest_occurence(const event& an_event) const
+        {
+            return __latest[checked_event(an_event)];
+        };
+
+        /// @brief Get the earliest finish date of an activity
+        constexpr duration earliest_finish(const activity& an_activity) const
+        {
+            const index a = checked_activity(an_activity);
+            return __earliest[__triggers[a]] + __durations[a];
+        };
+
+        /// @brief Get the latest start date of an activity
+        constexpr duration latest_start(const activity& an_activity) const
+        {
+            const index a = checked_activity(an_activity);
+            return __latest[__completions[a]] - __durations[a];
+        };
+
+        /// @brief Get the float of an activity, as network::activity_float
+        constexpr duration activity_float(const activity& an_activity) const
+        {
+            const index a = checked_activity(an_activity);
+            return __earliest[__completions[a]] - __earliest[__triggers[a]] - __durations[a];
+        };
+
+        /// @brief Get the free float of an activity, as network::free_float
+        constexpr duration free_float(const activity& an_activity) const
+        {
+            const index a = checked_activity(an_activity);
+            return __latest[__completions[a]] - __earliest[__triggers[a]] - __durations[a];
+        };
+
+        /// @brief Get the interfering float of an activity, as network::interfering_float
+        constexpr duration interfering_float(const activity& an_activity) const
+        {
+            const index a = checked_activity(an_activity);
+            const duration _float = __earliest[__completions[a]] - __latest[__triggers[a]] - __durations[a];
+            return _float < duration(0) ? duration(0) : _float;
+        };
+
+        /// @brief Get the independent float of an activity, as network::independent_float
+        constexpr duration independent_float(const activity& an_activity) const
+        {
+            return free_float(an_activity) - activity_float(an_activity);
+        };
+
+        /// @brief Get the dates and floats of every activity at once
+        constexpr float_report floats() const
+        {
+            float_report _report {};
+            for (index a = 0; a < __activity_count; ++a)
+            {
+                const duration _trigger_earliest = __earliest[__triggers[a]];
+                const duration _completion_earliest = __earliest[__completions[a]];
+                const duration _completion_latest = __latest[__completions[a]];
+                const duration _interfering = _completion_earliest - __latest[__triggers[a]] - __durations[a];
+                _report.earliest_start[a] = _trigger_earliest;
+                _report.earliest_finish[a] = _trigger_earliest + __durations[a];
+                _report.latest_finish[a] = _completion_latest;
+                _report.latest_start[a] = _completion_latest - __durations[a];
+                _report.activity_float[a] = _completion_earliest - _report.earliest_finish[a];
+                _report.free_float[a] = _completion_latest - _report.earliest_finish[a];
+                _report.interfering_float[a] = _interfering < duration(0) ? duration(0) : _interfering;
+                _report.independent_float[a] = _report.free_float[a] - _report.activity_float[a];
+            }
+            return _report;
+        };
+
+        /// @brief Get the completion time: the latest earliest occurence of the terminal events, or the initial time
+        constexpr duration completion() const
+        {
+            duration _completion = __initial_time;
+            for (index e = 0; e < __event_count; ++e)
+                if (__out_offsets[e] == __out_offsets[e + 1] and _completion < __earliest[e])
+                    _completion = __earliest[e];
+            return _completion;
+        };
+
+        /// @brief Find a critical path, with the ties of network::find_critical_path
+        /// @return activity segments ordered by precedence, empty if the network has no activity
+        constexpr path find_critical_path() const
+        {
+            path _path {};
+            index _last = npos;
+            for (index e = 0; e < __event_count; ++e)
+                if (__out_offsets[e] == __out_offsets[e + 1] and (_last == npos or __earliest[_last] < __earliest[e]))
+                    _last = e;
+            for (index e = _last; e != npos; )
+            {
+                index _tight = npos;
+                for (index k = __in_offsets[e]; _tight == npos and k != __in_offsets[e + 1]; ++k)
+                    if (__earliest[__triggers[__in_activities[k]]] + __durations[__in_activities[k]] == __earliest[e])
+                        _tight = __in_activities[k];
+                if (_tight == npos)
+                    break;
+                _path.segments[_path.count++] = segment { __activities[_tight], __durations[_tight] };
+                e = __triggers[_tight];
+            }
+            for (std::size_t i = 0; i < _path.count / 2; ++i)
+            {
+                const segment _swap = _path.segments[i];
+                _path.segments[i] = _path.segments[_path.count - 1 - i];
+                _path.segments[_path.count - 1 - i] = _swap;
+            }
+            return _path;
+        };
+
+    private:
+
+        constexpr index checked_event(const event& an_event) const
+        {
+            const index e = event_index(an_event);
+            if (e == npos)
+                throw std::out_of_range("event is not in the network");
+            return e;
+        };
+
+        constexpr index checked_activity(const activity& an_activity) const
+        {
+            const index a = activity_index(an_activity);
+            if (a == npos)
+                throw std::out_of_range("activity is not in the network");
+            return a;
+        };
+
+        /// @brief Insert an activity and its events in sorted position, without analysis
+        /// @return false if the activity or its reverse is already in the network
+        constexpr bool insert(const activity& an_activity, const duration& a_duration)
+        {
+            for (index a = 0; a < __activity_count; ++a)
+                if (__activities[a] == an_activity or __activities[a] == an_activity.reverse())
+                    return false;
+            if (__activity_count == Capacity)
+                throw std::length_error("fixed network is full");
+            index _position = __activity_count;
+            for (; _position > 0 and an_activity < __activities[_position - 1]; --_position)
+            {
+                __activities[_position] = __activities[_position - 1];
+                __durations[_position] = __durations[_position - 1];
+            }
+            __activities[_position] = an_activity;
+            __durations[_position] = a_duration;
+            ++__activity_count;
+            insert(an_activity.trigger_event());
+            insert(an_activity.completion_event());
+            return true;
+        };
+
+        /// @brief Insert an event in sorted position if it is not in the network
+        constexpr void insert(const event& an_event)
+        {
+            if (event_index(an_event) != npos)
+                return;
+            index _position = __event_count;
+            for (; _position > 0 and an_event < __events[_position - 1]; --_position)
+                __events[_position] = __events[_position - 1];
+            __events[_position] = an_event;
+            ++__event_count;
+        };
+
+        /// @brief Rebuild the adjacency, order the events (Kahn) and run the forward and backward passes
+        /// @throw std::logic_error if the network contains a loop
+        constexpr void analyse()
+        {
+            // endpoints and outgoing ranges (activities are sorted by trigger)
+            for (index e = 0; e <= __event_count; ++e)
+            {
+                __out_offsets[e] = 0;
+                __in_offsets[e] = 0;
+            }
+            for (index a = 0; a < __activity_count; ++a)
+            {
+                __triggers[a] = event_index(__activities[a].trigger_event());
+                __completions[a] = event_index(__activities[a].completion_event());
+                ++__out_offsets[__triggers[a] + 1];
+                ++__in_offsets[__completions[a] + 1];
+            }
+            for (index e = 0; e < __event_count; ++e)
+            {
+                __out_offsets[e + 1] += __out_offsets[e];
+                __in_offsets[e + 1] += __in_offsets[e];
+            }
+
+            // incoming activities grouped by completion, in activity order
+            std::array<index, 2 * Capacity + 1> _next {};
+            for (index e = 0; e < __event_count; ++e)
+                _next[e] = __in_offsets[e];
+            for (index a = 0; a < __activity_count; ++a)
+                __in_activities[_next[__completions[a]]++] = a;
+
+            // topological order
+            std::array<index, 2 * Capacity> _pending {};
+            std::array<index, 2 * Capacity> _order {};
+            std::size_t _ordered = 0;
+            __initial_count = 0;
+            __terminal_count = 0;
+            for (index e = 0; e < __event_count; ++e)
+            {
+                _pending[e] = __in_offsets[e + 1] - __in_offsets[e];
+                if (_pending[e] == 0)
+                {
+                    _order[_ordered++] = e;
+                    ++__initial_count;
+                }
+                if (__out_offsets[e] == __out_offsets[e + 1])
+                    ++__terminal_count;
+            }
+            for (std::size_t i = 0; i < _ordered; ++i)
+                for (index a = __out_offsets[_order[i]]; a != __out_offsets[_order[i] + 1]; ++a)
+                    if (--_pending[__completions[a]] == 0)
+                        _order[_ordered++] = __completions[a];
+            if (_ordered != __event_count)
+                throw std::logic_error("network contains a loop");
+
+            // - forward pass
+            for (std::size_t i = 0; i < _ordered; ++i)
+            {
+                const index e = _order[i];
+                __earliest[e] = __initial_time;
+                for (index k = __in_offsets[e]; k != __in_offsets[e + 1]; ++k)
+                {
+                    const index a = __in_activities[k];
+                    const duration _finish = __earliest[__triggers[a]] + __durations[a];
+                    __earliest[e] = k == __in_offsets[e] or __earliest[e] < _finish ? _finish : __earliest[e];
+                }
+            }
+
+            // - backward pass
+            for (std::size_t i = _ordered; i-- > 0; )
+            {
+                const index e = _order[i];
+                __latest[e] = __terminal_time;
+                for (index a = __out_offsets[e]; a != __out_offsets[e + 1]; ++a)
+                {
+                    const duration _start = __latest[__completions[a]] - __durations[a];
+                    __latest[e] = a == __out_offsets[e] or _start < __latest[e] ? _start : __latest[e];
+                }
+            }
+        };
+
+    // data members
+    private:
+        duration __initial_time {};
+        duration __terminal_time {};
+        std::size_t __event_count = 0;
+        std::size_t __activity_count = 0;
+        std::size_t __initial_count = 0;
+        std::size_t __terminal_count = 0;
+        std::array<event, 2 * Capacity> __events {};                ///< event index -> event id (sorted)
+        std::array<activity, Capacity> __activities {};             ///< activity index -> activity (sorted)
+        std::array<duration, Capacity> __durations {};
+        std::array<index, Capacity> __triggers {};                  ///< activity index -> trigger event index
+        std::array<index, Capacity> __completions {};               ///< activity index -> completion event index
+        std::array<index, 2 * Capacity + 1> __out_offsets {};       ///< event index -> first outgoing activity index
+        std::array<index, 2 * Capacity + 1> __in_offsets {};        ///< event index -> first slot in __in_activities
+        std::array<index, Capacity> __in_activities {};             ///< incoming activity indices grouped by completion event
+        std::array<duration, 2 * Capacity> __earliest {};           ///< event index -> earliest occurence
+        std::array<duration, 2 * Capacity> __latest {};             ///< event index -> latest occurence
+
+    };
+
+} // namespace pert
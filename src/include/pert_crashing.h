@@ -0,0 +1,370 @@
+/***
+ * @brief This file describes a time-cost trade-off solver which crashes the cheapest cuts of critical activities.
+ * @author Johann Fotsing
+ * @date 2026-10-16
+ * @file pert_crashing.h
+ */
+
+#pragma once
+
+#include <pert.h>
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+namespace pert
+{
+
+    /**
+     * @brief This class computes the time-cost curve of a network whose activities have crash options (see network::set_crash).
+     * Each step crashes the minimum cost cut of the critical subnetwork, found by a max-flow on the tight activities,
+     * by as much as the cut activities allow or until another path becomes critical. Durations are edited on a copy
+     * of the network with set_estimated_duration, so that event times are only propagated where they move.
+     * Cuts never cross a critical path twice (reverse capacities are infinite), so crashing a cut keeps every
+     * critical activity critical: the critical subnetwork and the capacities only grow from step to step, and the
+     * flow of a step is the starting flow of the next one.
+     * Crashed activities are never lengthened back, so the curve is the minimum cost one as long as no step would
+     * gain from doing so.
+     *
+     * @tparam EventIDType type of the network's event objects
+     * @tparam DurationType type of the network's duration objects
+     */
+    template<typename EventIDType, typename DurationType>
+    class crashing
+    {
+
+    public:
+
+        /// @brief context types
+        using network_type = network<EventIDType, DurationType>;
+        using activity = typename network_type::activity;
+        using duration = DurationType;
+        using adjacency = typename network_type::adjacency;
+        using index = typename adjacency::index;
+
+        /// @brief Solver settings
+        struct options
+        {
+            std::optional<duration> target;     ///< stop once completion is no later than this time, crash as much as possible otherwise
+            std::size_t max_steps = std::numeric_limits<std::size_t>::max();
+        };
+
+        /// @brief A point of the time-cost curve
+        struct step
+        {
+            duration completion;                ///< network completion time after the step
+            double cost;                        ///< total crash cost up to this step
+            double slope;                       ///< cost per duration unit of the step
+            duration reduction;                 ///< duration removed from each crashed activity
+            std::vector<activity> crashed;      ///< activities of the step's cut
+        };
+
+        /// @brief Time-cost curve
+        struct result
+        {
+            std::vector<step> curve;            ///< the starting network first, then one point per step
+            std::vector<activity> activities;   ///< network activities
+            std::vector<duration> durations;    ///< crashed duration by activity, at the last point of the curve
+        };
+
+    public:
+
+        /// @brief Prepare the crashing of a network. The solver works on its own copy of the network.
+        /// @param a_network a well formed network
+        crashing(const network_type& a_network) : __network(a_network)
+        {
+            const adjacency& _adjacency = __network.compiled();
+            if (not _adjacency.acyclic())
+                throw std::logic_error("network contains a loop");
+            if (_adjacency.link_count() > 0)
+                throw std::invalid_argument("crashing does not support precedence constraints");
+
+            double _total = 0.;
+            __limits.reserve(_adjacency.activity_count());
+            __slopes.reserve(_adjacency.activity_count());
+            for (index a = 0; a < _adjacency.activity_count(); ++a)
+            {
+                const auto _crash = __network.get_crash(_adjacency.activities[a]);
+                if (_crash and _crash->cost_slope < 0.)
+                    throw std::invalid_argument("negative cost slope");
+                __limits.push_back(_crash ? std::min(_crash->crash_duration, _adjacency.durations[a]) : _adjacency.durations[a]);
+                __slopes.push_back(_crash ? _crash->cost_slope : 0.);
+                _total += __slopes.back();
+            }
+
+            // any cut of crashable activities costs less than the infinite capacity
+            __infinite = 2. * _total + 1.;
+            __slots.assign(_adjacency.activity_count(), __unlinked);
+            __linked.assign(_adjacency.event_count(), false);
+            __visited.assign(_adjacency.event_count(), false);
+            __heads.assign(_adjacency.event_count() + 2, -1);
+            __network.times();
+        };
+
+        /// @brief Crash the network step by step
+        /// @param some_options solver settings
+        /// @return the time-cost curve; solving again continues from its last point
+        result solve(const options& some_options = options())
+        {
+            const adjacency& _adjacency = __network.compiled();
+            result _result;
+            duration _completion = completion();
+            _result.curve.push_back({ _completion, __cost, 0., duration(0), {} });
+
+            while (_result.curve.size() <= some_options.max_steps and not (some_options.target and not (*some_options.target < _completion)))
+            {
+                const std::vector<index> _cut = min_cut(_completion);
+                if (_cut.empty())
+                    break;
+
+                // crash by as much as the cut allows, then give back what did not shorten the network
+                duration _reduction = _adjacency.durations[_cut.front()] - __limits[_cut.front()];
+                for (const index a: _cut)
+                    _reduction = std::min(_reduction, _adjacency.durations[a] - __limits[a]);
+                if (some_options.target)
+                    _reduction = std::min(_reduction, _completion - *some_options.target);
+                std::vector<duration> _durations;
+                for (const index a: _cut)
+                {
+                    _durations.push_back(_adjacency.durations[a]);
+                    __network.set_estimated_duration(_adjacency.activities[a], _adjacency.durations[a] - _reduction);
+                }
+                const duration _gain = _completion - completion();
+                if (_gain < _reduction)
+                {
+                    for (std::size_t i = 0; i < _cut.size(); ++i)
+                        __network.set_estimated_duration(_adjacency.activities[_cut[i]], _durations[i] - _gain);
+                }
+                if (not (duration(0) < _gain))
+                    break;
+
+                step _step { _completion - _gain, 0., 0., _gain, {} };
+                for (const index a: _cut)
+                {
+                    _step.slope += __slopes[a];
+                    _step.crashed.push_back(_adjacency.activities[a]);
+
+                    // activities crashed to their limit can no longer be cut
+                    if (not (__limits[a] < _adjacency.durations[a]))
+                        __edges[__slots[a]].capacity += __infinite;
+                }
+                __cost += _step.slope * static_cast<double>(_gain);
+                _step.cost = __cost;
+                _completion = _step.completion;
+                _result.curve.push_back(std::move(_step));
+            }
+
+            _result.activities.assign(_adjacency.activities.cbegin(), _adjacency.activities.cend());
+            _result.durations.assign(_adjacency.durations.cbegin(), _adjacency.durations.cend());
+            return _result;
+        };
+
+        /// @brief Get the crashed network
+        const network_type& crashed_network() const
+        {
+            return __network;
+        };
+
+    private:
+
+        /// @brief Residual graph edge; edges come in pairs, an edge and its reverse
+        struct edge
+        {
+            index to;
+            double capacity;
+            std::ptrdiff_t next;    ///< next edge out of the same node, -1 for none
+        };
+
+        /// @brief Residual graph nodes: the source, the sink, then the network's events
+        static constexpr index __source = 0;
+        static constexpr index __sink = 1;
+        static constexpr std::ptrdiff_t __unlinked = -1;
+        static constexpr double __epsilon = 1e-12;
+
+        /// @brief Get the network's completion time: the latest earliest occurence of terminal events
+        duration completion() const
+        {
+            const adjacency& _adjacency = __network.compiled();
+            const auto& _times = __network.times();
+            duration _completion = __network.initial_time();
+            for (const index e: _adjacency.terminal)
+                _completion = std::max(_completion, _times.earliest[e]);
+            return _completion;
+        };
+
+        /// @brief Find the minimum cost set of crashable activities crossing every critical path once
+        /// @param a_completion network completion time
+        /// @return the cut activities, empty if every cut contains an activity which cannot be crashed
+        std::vector<index> min_cut(const duration& a_completion)
+        {
+            const adjacency& _adjacency = __network.compiled();
+            const auto& _times = __network.times();
+
+            // link the critical subnetwork's new parts: tight activities reached backward from the terminal events
+            // occuring last, chain starts to the source and those terminal events to the sink
+            __events.clear();
+            __critical.clear();
+            for (const index e: _adjacency.terminal)
+            {
+                if (not (_times.earliest[e] == a_completion))
+                    continue;
+                __visited[e] = true;
+                __events.push_back(e);
+                if (not __linked[e])
+                    link(e + 2, __sink, __infinite, 0.);
+                __linked[e] = true;
+            }
+            for (std::size_t i = 0; i < __events.size(); ++i)
+            {
+                const index e = __events[i];
+                if (_adjacency.in_begin(e) == _adjacency.in_end(e) and not __linked[e])
+                {
+                    link(__source, e + 2, __infinite, 0.);
+                    __linked[e] = true;
+                }
+                for (const index* a = _adjacency.in_begin(e); a != _adjacency.in_end(e); ++a)
+                {
+                    const index t = _adjacency.triggers[*a];
+                    if (not (_times.earliest[t] + _adjacency.durations[*a] == _times.earliest[e]))
+                        continue;
+                    __critical.push_back(*a);
+                    if (__slots[*a] == __unlinked)
+                        __slots[*a] = link(t + 2, e + 2, __limits[*a] < _adjacency.durations[*a] ? __slopes[*a] : __infinite, __infinite);
+                    if (not __visited[t])
+                    {
+                        __visited[t] = true;
+                        __events.push_back(t);
+                    }
+                }
+            }
+            for (const index e: __events)
+                __visited[e] = false;
+
+            // cut: critical activities from events still reachable from the source to events which are not
+            std::vector<index> _cut;
+            if (max_flow())
+            {
+                for (const index a: __critical)
+                    if (__levels[_adjacency.triggers[a] + 2] >= 0 and __levels[_adjacency.completions[a] + 2] < 0)
+                        _cut.push_back(a);
+            }
+            return _cut;
+        };
+
+        /// @brief Add an edge and its reverse to the residual graph
+        /// @return the edge's position
+        std::ptrdiff_t link(index a_from, index a_to, double a_capacity, double a_reverse_capacity)
+        {
+            __edges.push_back({ a_to, a_capacity, __heads[a_from] });
+            __heads[a_from] = static_cast<std::ptrdiff_t>(__edges.size() - 1);
+            __edges.push_back({ a_from, a_reverse_capacity, __heads[a_to] });
+            __heads[a_to] = static_cast<std::ptrdiff_t>(__edges.size() - 1);
+            return __heads[a_from];
+        };
+
+        /// @brief Compute levels from the source over residual edges (-1 for unreachable nodes), up to the sink's level
+        bool levels()
+        {
+            __levels.assign(__heads.size(), -1);
+            __queue.assign(1, __source);
+            __levels[__source] = 0;
+            for (std::size_t i = 0; i < __queue.size(); ++i)
+            {
+                const index u = __queue[i];
+                if (__levels[__sink] >= 0 and __levels[u] >= __levels[__sink])
+                    break;
+                for (std::ptrdiff_t e = __heads[u]; e >= 0; e = __edges[e].next)
+                {
+                    if (__edges[e].capacity > __epsilon and __levels[__edges[e].to] < 0)
+                    {
+                        __levels[__edges[e].to] = __levels[u] + 1;
+                        __queue.push_back(__edges[e].to);
+                    }
+                }
+            }
+            return __levels[__sink] >= 0;
+        };
+
+        /// @brief Augment the flow to a maximum with Dinic's algorithm and an iterative path search.
+        ///        When it returns true, the levels mark the nodes left reachable from the source.
+        /// @return false if the flow reaches the infinite capacity, i.e. there is no finite cut
+        bool max_flow()
+        {
+            while (levels())
+            {
+                __next.assign(__heads.cbegin(), __heads.cend());
+                __path.clear();
+                index u = __source;
+                while (true)
+                {
+                    if (u == __sink)
+                    {
+                        double _bottleneck = __infinite;
+                        for (const std::ptrdiff_t e: __path)
+                            _bottleneck = std::min(_bottleneck, __edges[e].capacity);
+                        for (const std::ptrdiff_t e: __path)
+                        {
+                            __edges[e].capacity -= _bottleneck;
+                            __edges[e ^ 1].capacity += _bottleneck;
+                        }
+                        __flow += _bottleneck;
+                        if (__flow >= __infinite)
+                            return false;
+
+                        // resume from the tail of the first saturated edge
+                        const auto _saturated = std::find_if(__path.cbegin(), __path.cend(), [this](std::ptrdiff_t e) { return not (__edges[e].capacity > __epsilon); });
+                        __path.resize(_saturated - __path.cbegin());
+                        u = __path.empty() ? __source : __edges[__path.back()].to;
+                        continue;
+                    }
+
+                    // advance along the level graph, or retreat from a dead end
+                    std::ptrdiff_t& e = __next[u];
+                    while (e >= 0 and not (__edges[e].capacity > __epsilon and __levels[__edges[e].to] == __levels[u] + 1))
+                        e = __edges[e].next;
+                    if (e >= 0)
+                    {
+                        __path.push_back(e);
+                        u = __edges[e].to;
+                        continue;
+                    }
+                    if (__path.empty())
+                        break;
+                    __levels[u] = -1;
+                    u = __edges[__path.back() ^ 1].to;
+                    __path.pop_back();
+                    __next[u] = __edges[__next[u]].next;
+                }
+            }
+            return true;
+        };
+
+    // data members
+    private:
+        network_type __network;
+        std::vector<duration> __limits;         ///< activity index -> crash duration
+        std::vector<double> __slopes;           ///< activity index -> cost per duration unit removed
+        double __infinite = 1.;
+        double __cost = 0.;                     ///< total crash cost so far
+
+        // residual graph, kept from step to step with its flow
+        std::vector<edge> __edges;
+        std::vector<std::ptrdiff_t> __heads;    ///< node -> first edge, -1 for none
+        std::vector<std::ptrdiff_t> __slots;    ///< activity index -> edge, __unlinked outside the critical subnetwork
+        std::vector<bool> __linked;             ///< event index -> linked to the source or the sink
+        double __flow = 0.;
+
+        // scratch buffers
+        std::vector<bool> __visited;            ///< event index -> reached by the critical subnetwork search
+        std::vector<index> __events;
+        std::vector<index> __critical;          ///< critical activities
+        std::vector<std::ptrdiff_t> __next;     ///< node -> next edge to try in the current phase
+        std::vector<std::ptrdiff_t> __path;
+        std::vector<std::ptrdiff_t> __levels;
+        std::vector<index> __queue;
+
+    };
+
+} // namespace pert
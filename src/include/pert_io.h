@@ -0,0 +1,618 @@
+/***
+ * @brief This file describes how activity networks are loaded from and saved to files.
+ * @author Johann Fotsing
+ * @date 2026-10-16
+ * @file pert_io.h
+ */
+
+#pragma once
+
+#include <pert.h>
+#include <cstdint>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace pert
+{
+
+    /**
+     * @brief Read-only memory mapping of a whole file.
+     * The mapping is released when the object is destroyed.
+     *
+     */
+    class memory_map
+    {
+
+    public:
+        /// @brief Map a file
+        /// @param a_file_name path of the file
+        /// @throw std::runtime_error if the file cannot be opened or mapped
+        memory_map(const std::string& a_file_name) : __data(nullptr), __size(0)
+        {
+            const int _descriptor = ::open(a_file_name.c_str(), O_RDONLY);
+            if (_descriptor < 0)
+                throw std::runtime_error("cannot open " + a_file_name);
+            struct stat _status;
+            if (::fstat(_descriptor, &_status) != 0)
+            {
+                ::close(_descriptor);
+                throw std::runtime_error("cannot stat " + a_file_name);
+            }
+            __size = static_cast<std::size_t>(_status.st_size);
+            if (__size > 0)
+            {
+                void* _address = ::mmap(nullptr, __size, PROT_READ, MAP_PRIVATE, _descriptor, 0);
+                if (_address == MAP_FAILED)
+                {
+                    ::close(_descriptor);
+                    throw std::runtime_error("cannot map " + a_file_name);
+                }
+                __data = static_cast<const char*>(_address);
+                ::madvise(_address, __size, MADV_SEQUENTIAL);
+            }
+            ::close(_descriptor);
+        }
+
+        memory_map(const memory_map&) = delete;
+        memory_map& operator=(const memory_map&) = delete;
+
+        memory_map(memory_map&& a_map) noexcept : __data(a_map.__data), __size(a_map.__size)
+        {
+            a_map.__data = nullptr;
+            a_map.__size = 0;
+        }
+
+        ~memory_map()
+        {
+            if (__data != nullptr)
+                ::munmap(const_cast<char*>(__data), __size);
+        }
+
+        /// @brief Get the mapped bytes
+        const char* data() const { return __data; }
+
+        /// @brief Get the number of mapped bytes
+        std::size_t size() const { return __size; }
+
+        /// @brief Get the mapped bytes as text
+        std::string_view view() const { return std::string_view(__data, __size); }
+
+    private:
+        const char* __data;
+        std::size_t __size;
+    };
+
+    /// @brief Load a network from a text description file (see network::from_txt) without copying the file in memory
+    /// @param a_file_name path of the network description
+    /// @param threads number of parsing threads, 0 for every hardware thread
+    /// @return network object
+    /// @throw parse_error listing the malformed lines
+    template<typename EventIDType, typename DurationType>
+    network<EventIDType, DurationType> load_txt(const std::string& a_file_name, unsigned threads = 0)
+    {
+        const memory_map _map(a_file_name);
+        return network<EventIDType, DurationType>::from_txt(_map.view(), threads);
+    }
+
+    /// @brief Append a value to a text buffer, through std::to_chars for arithmetic values
+    template<typename T>
+    void append_text(std::string& a_buffer, const T& a_value)
+    {
+        if constexpr (std::is_arithmetic_v<T>)
+        {
+            char _digits[64];
+            const auto _result = std::to_chars(_digits, _digits + sizeof(_digits), a_value);
+            a_buffer.append(_digits, _result.ptr);
+        }
+        else
+        {
+            std::ostringstream _stream;
+            _stream << a_value;
+            a_buffer += _stream.str();
+        }
+    }
+
+    /// @brief Append a text to a buffer as a JSON string, quoted and escaped
+    inline void append_json_string(std::string& a_buffer, std::string_view a_text)
+    {
+        a_buffer += '"';
+        for (const char c: a_text)
+        {
+            switch (c)
+            {
+            case '"': a_buffer += "\\\""; break;
+            case '\\': a_buffer += "\\\\"; break;
+            case '\n': a_buffer += "\\n"; break;
+            case '\r': a_buffer += "\\r"; break;
+            case '\t': a_buffer += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    char _escape[8];
+                    std::snprintf(_escape, sizeof(_escape), "\\u%04x", static_cast<unsigned>(c));
+                    a_buffer += _escape;
+                }
+                else
+                    a_buffer += c;
+            }
+        }
+        a_buffer += '"';
+    }
+
+    /// @brief Append a value to a JSON buffer: arithmetic values as numbers, other values as strings
+    template<typename T>
+    void append_json(std::string& a_buffer, const T& a_value)
+    {
+        if constexpr (std::is_arithmetic_v<T>)
+            append_text(a_buffer, a_value);
+        else
+        {
+            std::string _text;
+            append_text(_text, a_value);
+            append_json_string(a_buffer, _text);
+        }
+    }
+
+    /// @brief Write the dates and floats of every activity as delimited text (CSV by default, TSV with a tab separator).
+    ///        Rows are formatted into a buffer flushed every few thousand rows, one row per activity in compiled() order.
+    /// @param an_output the output stream
+    /// @param a_network the network to report on
+    /// @param a_separator the field separator
+    template<typename EventIDType, typename DurationType>
+    void write_floats(std::ostream& an_output, const network<EventIDType, DurationType>& a_network, char a_separator = ',')
+    {
+        const auto& _adjacency = a_network.compiled();
+        const auto _report = a_network.floats();
+        std::string _buffer;
+        for (const char* _name: { "trigger", "completion", "duration", "earliest_start", "earliest_finish", "latest_start", "latest_finish",
+                                  "activity_float", "free_float", "interfering_float", "independent_float" })
+            (_buffer += _name) += a_separator;
+        _buffer.back() = '\n';
+        for (std::size_t a = 0; a < _adjacency.activity_count(); ++a)
+        {
+            append_text(_buffer, _adjacency.activities[a].trigger_event());
+            _buffer += a_separator;
+            append_text(_buffer, _adjacency.activities[a].completion_event());
+            for (const DurationType& _field: { _adjacency.durations[a], _report.earliest_start[a], _report.earliest_finish[a], _report.latest_start[a], _report.latest_finish[a],
+                                               _report.activity_float[a], _report.free_float[a], _report.interfering_float[a], _report.independent_float[a] })
+            {
+                _buffer += a_separator;
+                append_text(_buffer, _field);
+            }
+            _buffer += '\n';
+            if (_buffer.size() > (1 << 16))
+            {
+                an_output.write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+                _buffer.clear();
+            }
+        }
+        an_output.write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+    }
+
+    /// @brief Write the duration sensitivity of every activity (see network::sensitivity) as delimited text,
+    ///        one row per activity in compiled() order
+    /// @param an_output the output stream
+    /// @param a_network the network to report on
+    /// @param a_separator the field separator
+    template<typename EventIDType, typename DurationType>
+    void write_sensitivity(std::ostream& an_output, const network<EventIDType, DurationType>& a_network, char a_separator = ',')
+    {
+        const auto& _adjacency = a_network.compiled();
+        const auto _report = a_network.sensitivity();
+        std::string _buffer;
+        for (const char* _name: { "trigger", "completion", "duration", "total_float", "lower", "upper", "relief" })
+            (_buffer += _name) += a_separator;
+        _buffer.back() = '\n';
+        for (std::size_t a = 0; a < _adjacency.activity_count(); ++a)
+        {
+            append_text(_buffer, _adjacency.activities[a].trigger_event());
+            _buffer += a_separator;
+            append_text(_buffer, _adjacency.activities[a].completion_event());
+            for (const DurationType& _field: { _adjacency.durations[a], _report.total_float[a], _report.lower[a], _report.upper[a], _report.relief[a] })
+            {
+                _buffer += a_separator;
+                append_text(_buffer, _field);
+            }
+            _buffer += '\n';
+            if (_buffer.size() > (1 << 16))
+            {
+                an_output.write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+                _buffer.clear();
+            }
+        }
+        an_output.write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+    }
+
+    /**
+     * @brief Versioned binary snapshot of a compiled network, usable read-only straight from a memory mapping.
+     * A snapshot holds the event table, the CSR adjacency, the durations, the precedence constraints with their compiled
+     * links, the schedule and optionally the event times.
+     * Every array is stored in native layout behind a header (magic, version, byte order, type sizes, counts, checksum),
+     * so opening a snapshot is a single mmap followed by header and checksum checks, with no per-element deserialization.
+     *
+     * @tparam EventIDType type of the network's event objects, trivially copyable
+     * @tparam DurationType type of the network's duration objects, trivially copyable
+     */
+    template<typename EventIDType, typename DurationType>
+    class snapshot
+    {
+
+    public:
+
+        /// @brief context types
+        using network_type = network<EventIDType, DurationType>;
+        using event = EventIDType;
+        using duration = DurationType;
+        using activity = typename network_type::activity;
+        using precedence_constraint = typename network_type::precedence_constraint;
+        using index = std::uint64_t;
+        static constexpr index npos = static_cast<index>(-1);
+        static constexpr std::uint32_t version = 2;
+
+        static_assert(std::is_trivially_copyable_v<event> and std::is_trivially_copyable_v<duration>, "snapshots store events and durations as raw bytes");
+
+    public:
+
+        /// @brief Save a network as a snapshot file
+        /// @param a_network the network to save
+        /// @param a_file_name path of the snapshot file
+        /// @param with_times also save the event times (the network must have no loop)
+        static void save(const network_type& a_network, const std::string& a_file_name, bool with_times = true)
+        {
+            const auto& _adjacency = a_network.compiled();
+            const std::vector<precedence_constraint> _constraints = a_network.constraints();
+            header _header {};
+            std::memcpy(_header.magic, __magic, sizeof(_header.magic));
+            _header.version = version;
+            _header.byte_order = __byte_order;
+            _header.event_size = sizeof(event);
+            _header.duration_size = sizeof(duration);
+            _header.types = type_tag<event>() << 8 | type_tag<duration>();
+            _header.event_count = _adjacency.event_count();
+            _header.activity_count = _adjacency.activity_count();
+            _header.link_count = _adjacency.link_count();
+            _header.constraint_count = _constraints.size();
+            _header.initial_count = _adjacency.initial.size();
+            _header.terminal_count = _adjacency.terminal.size();
+            _header.order_count = _adjacency.order.size();
+            _header.has_times = with_times and _adjacency.acyclic() ? 1 : 0;
+
+            // payload sections, in layout order
+            const sections _sections = layout(_header);
+            std::vector<char> _payload(_sections.size, 0);
+            const auto _write_indices = [&_payload](std::size_t an_offset, const std::pmr::vector<typename network_type::adjacency::index>& some_indices)
+            {
+                for (std::size_t i = 0; i < some_indices.size(); ++i)
+                {
+                    const index _index = some_indices[i] == network_type::adjacency::npos ? npos : static_cast<index>(some_indices[i]);
+                    std::memcpy(_payload.data() + an_offset + i * sizeof(index), &_index, sizeof(index));
+                }
+            };
+            const duration _schedule[2] = { a_network.initial_time(), a_network.terminal_time() };
+            std::memcpy(_payload.data() + _sections.schedule, _schedule, sizeof(_schedule));
+            std::memcpy(_payload.data() + _sections.events, _adjacency.events.data(), _adjacency.event_count() * sizeof(event));
+            std::memcpy(_payload.data() + _sections.durations, _adjacency.durations.data(), _adjacency.durations.size() * sizeof(duration));
+            _write_indices(_sections.triggers, _adjacency.triggers);
+            _write_indices(_sections.completions, _adjacency.completions);
+            _write_indices(_sections.out_offsets, _adjacency.out_offsets);
+            _write_indices(_sections.in_offsets, _adjacency.in_offsets);
+            _write_indices(_sections.in_edges, _adjacency.in_edges);
+            for (std::size_t i = 0; i < _constraints.size(); ++i)
+            {
+                const precedence_constraint& c = _constraints[i];
+                const event _events[4] = { c.predecessor.trigger_event(), c.predecessor.completion_event(), c.successor.trigger_event(), c.successor.completion_event() };
+                const index _relation = static_cast<index>(c.relation);
+                std::memcpy(_payload.data() + _sections.constraint_events + i * sizeof(_events), _events, sizeof(_events));
+                std::memcpy(_payload.data() + _sections.constraint_relations + i * sizeof(index), &_relation, sizeof(index));
+                std::memcpy(_payload.data() + _sections.constraint_lags + i * sizeof(duration), &c.lag, sizeof(duration));
+            }
+            _write_indices(_sections.initial, _adjacency.initial);
+            _write_indices(_sections.terminal, _adjacency.terminal);
+            _write_indices(_sections.order, _adjacency.order);
+            if (_header.has_times)
+            {
+                const auto& _times = a_network.times();
+                std::memcpy(_payload.data() + _sections.earliest, _times.earliest.data(), _adjacency.event_count() * sizeof(duration));
+                std::memcpy(_payload.data() + _sections.latest, _times.latest.data(), _adjacency.event_count() * sizeof(duration));
+            }
+            _header.payload_size = _payload.size();
+            _header.checksum = checksum(_payload.data(), _payload.size());
+
+            std::ofstream _file(a_file_name, std::ios::binary | std::ios::trunc);
+            _file.write(reinterpret_cast<const char*>(&_header), sizeof(_header));
+            _file.write(_payload.data(), static_cast<std::streamsize>(_payload.size()));
+            if (not _file)
+                throw std::runtime_error("cannot write " + a_file_name);
+        };
+
+        /// @brief Open a snapshot file
+        /// @param a_file_name path of the snapshot file
+        /// @param verify check the payload checksum
+        /// @throw std::runtime_error if the file is not a snapshot of this version, byte order and types, or is corrupted
+        snapshot(const std::string& a_file_name, bool verify = true) : __map(a_file_name)
+        {
+            if (__map.size() < sizeof(header))
+                throw std::runtime_error(a_file_name + ": not a network snapshot");
+            std::memcpy(&__header, __map.data(), sizeof(header));
+            if (std::memcmp(__header.magic, __magic, sizeof(__header.magic)) != 0)
+                throw std::runtime_error(a_file_name + ": not a network snapshot");
+            if (__header.version != version)
+                throw std::runtime_error(a_file_name + ": unsupported snapshot version " + std::to_string(__header.version));
+            if (__header.byte_order != __byte_order)
+                throw std::runtime_error(a_file_name + ": snapshot byte order differs from this machine's");
+            if (__header.event_size != sizeof(event) or __header.duration_size != sizeof(duration) or __header.types != (type_tag<event>() << 8 | type_tag<duration>()))
+                throw std::runtime_error(a_file_name + ": snapshot event or duration types differ");
+            __sections = layout(__header);
+            if (__header.payload_size != __sections.size or __map.size() != sizeof(header) + __sections.size)
+                throw std::runtime_error(a_file_name + ": truncated snapshot");
+            __payload = __map.data() + sizeof(header);
+            if (verify and checksum(__payload, __sections.size) != __header.checksum)
+                throw std::runtime_error(a_file_name + ": snapshot checksum mismatch");
+        };
+
+        /// @brief Get the number of events
+        std::size_t event_count() const { return __header.event_count; }
+
+        /// @brief Get the number of activities
+        std::size_t activity_count() const { return __header.activity_count; }
+
+        /// @brief Get the number of precedence constraint links, stored as edges after the activities
+        std::size_t link_count() const { return __header.link_count; }
+
+        /// @brief Get the number of precedence constraints
+        std::size_t constraint_count() const { return __header.constraint_count; }
+
+        /// @brief Get the sorted event table
+        const event* events() const { return array<event>(__sections.events); }
+
+        /// @brief Get the activity durations then the link lags, by edge index
+        const duration* durations() const { return array<duration>(__sections.durations); }
+
+        /// @brief Get the trigger event index of each edge (activities, then links, each sorted by trigger then completion)
+        const index* triggers() const { return array<index>(__sections.triggers); }
+
+        /// @brief Get the completion event index of each edge
+        const index* completions() const { return array<index>(__sections.completions); }
+
+        /// @brief Get the first outgoing activity of each event (event_count() + 1 values)
+        const index* out_offsets() const { return array<index>(__sections.out_offsets); }
+
+        /// @brief Get the first slot of each event in in_edges() (event_count() + 1 values)
+        const index* in_offsets() const { return array<index>(__sections.in_offsets); }
+
+        /// @brief Get the incoming edges grouped by completion event, activities first
+        const index* in_edges() const { return array<index>(__sections.in_edges); }
+
+        /// @brief Get the events in topological order
+        const index* order() const { return array<index>(__sections.order); }
+
+        /// @brief Get the network's scheduled initial time
+        duration initial_time() const { return array<duration>(__sections.schedule)[0]; }
+
+        /// @brief Get the network's scheduled terminal time
+        duration terminal_time() const { return array<duration>(__sections.schedule)[1]; }
+
+        /// @brief Check whether the snapshot holds event times
+        bool has_times() const { return __header.has_times != 0; }
+
+        /// @brief Get the initial events
+        std::vector<event> initial_events() const { return events_of(__sections.initial, __header.initial_count); }
+
+        /// @brief Get the terminal events
+        std::vector<event> terminal_events() const { return events_of(__sections.terminal, __header.terminal_count); }
+
+        /// @brief Get the index of an event
+        /// @return the event index, npos if the event is not in the snapshot
+        index event_index(const event& an_event) const
+        {
+            const event* _events = events();
+            const event* _search = std::lower_bound(_events, _events + event_count(), an_event);
+            if (_search == _events + event_count() or an_event < *_search)
+                return npos;
+            return static_cast<index>(_search - _events);
+        };
+
+        /// @brief Get the index of an activity
+        /// @return the activity index, npos if the activity is not in the snapshot
+        index activity_index(const activity& an_activity) const
+        {
+            const index _trigger = event_index(an_activity.trigger_event());
+            const index _completion = event_index(an_activity.completion_event());
+            if (_trigger == npos or _completion == npos)
+                return npos;
+            const index* _completions = completions();
+            const index* _first = _completions + out_offsets()[_trigger];
+            const index* _last = _completions + out_offsets()[_trigger + 1];
+            const index* _search = std::lower_bound(_first, _last, _completion);
+            return _search != _last and *_search == _completion ? static_cast<index>(_search - _completions) : npos;
+        };
+
+        /// @brief Get an activity by index
+        activity activity_at(index an_activity) const
+        {
+            return activity(events()[triggers()[an_activity]], events()[completions()[an_activity]]);
+        };
+
+        /// @brief Get the estimated duration of an activity
+        /// @throw std::out_of_range if the activity is not in the snapshot
+        duration estimated_duration(const activity& an_activity) const
+        {
+            return durations()[checked(activity_index(an_activity))];
+        };
+
+        /// @brief Get the saved earliest occurence of an event
+        /// @throw std::out_of_range if the event is not in the snapshot, std::logic_error if the snapshot has no times
+        duration earliest_occurence(const event& an_event) const
+        {
+            return times(__sections.earliest)[checked(event_index(an_event))];
+        };
+
+        /// @brief Get the saved latest occurence of an event
+        /// @throw std::out_of_range if the event is not in the snapshot, std::logic_error if the snapshot has no times
+        duration latest_occurence(const event& an_event) const
+        {
+            return times(__sections.latest)[checked(event_index(an_event))];
+        };
+
+        /// @brief Get the precedence constraints, in no particular order
+        std::vector<precedence_constraint> constraints() const
+        {
+            std::vector<precedence_constraint> _constraints;
+            _constraints.reserve(constraint_count());
+            for (std::size_t i = 0; i < constraint_count(); ++i)
+            {
+                const event* _events = array<event>(__sections.constraint_events) + 4 * i;
+                _constraints.push_back({ activity(_events[0], _events[1]), activity(_events[2], _events[3]),
+                                         static_cast<precedence>(array<index>(__sections.constraint_relations)[i]), array<duration>(__sections.constraint_lags)[i] });
+            }
+            return _constraints;
+        };
+
+        /// @brief Build an owned network from the snapshot
+        network_type to_network() const
+        {
+            std::vector<typename network_type::segment> _segments;
+            _segments.reserve(activity_count());
+            for (index a = 0; a < activity_count(); ++a)
+                _segments.emplace_back(activity_at(a), durations()[a]);
+            network_type _network;
+            _network.add_activities(std::move(_segments));
+            for (const precedence_constraint& c: constraints())
+                _network.add_constraint(c.predecessor, c.successor, c.relation, c.lag);
+            _network.schedule(initial_time(), terminal_time());
+            return _network;
+        };
+
+    private:
+
+        /// @brief Fixed size file header
+        struct header
+        {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t byte_order;
+            std::uint32_t event_size;
+            std::uint32_t duration_size;
+            std::uint32_t types;
+            std::uint32_t has_times;
+            std::uint64_t event_count;
+            std::uint64_t activity_count;
+            std::uint64_t link_count;
+            std::uint64_t constraint_count;
+            std::uint64_t initial_count;
+            std::uint64_t terminal_count;
+            std::uint64_t order_count;
+            std::uint64_t payload_size;
+            std::uint64_t checksum;
+        };
+
+        /// @brief Byte offsets of the payload sections, each aligned on 8 bytes
+        struct sections
+        {
+            std::size_t schedule, events, durations, triggers, completions, out_offsets, in_offsets, in_edges, constraint_events, constraint_relations, constraint_lags,
+                        initial, terminal, order, earliest, latest, size;
+        };
+
+        static constexpr char __magic[8] = { 'P', 'E', 'R', 'T', 'S', 'N', 'A', 'P' };
+        static constexpr std::uint32_t __byte_order = 0x01020304;
+
+        /// @brief Compute the payload layout from the header counts
+        static sections layout(const header& a_header)
+        {
+            sections _sections {};
+            std::size_t _offset = 0;
+            const auto _section = [&_offset](std::size_t a_size)
+            {
+                const std::size_t _start = _offset;
+                _offset += (a_size + 7) / 8 * 8;
+                return _start;
+            };
+            _sections.schedule = _section(2 * sizeof(duration));
+            _sections.events = _section(a_header.event_count * sizeof(event));
+            const std::uint64_t _edge_count = a_header.activity_count + a_header.link_count;
+            _sections.durations = _section(_edge_count * sizeof(duration));
+            _sections.triggers = _section(_edge_count * sizeof(index));
+            _sections.completions = _section(_edge_count * sizeof(index));
+            _sections.out_offsets = _section((a_header.event_count + 1) * sizeof(index));
+            _sections.in_offsets = _section((a_header.event_count + 1) * sizeof(index));
+            _sections.in_edges = _section(_edge_count * sizeof(index));
+            _sections.constraint_events = _section(a_header.constraint_count * 4 * sizeof(event));
+            _sections.constraint_relations = _section(a_header.constraint_count * sizeof(index));
+            _sections.constraint_lags = _section(a_header.constraint_count * sizeof(duration));
+            _sections.initial = _section(a_header.initial_count * sizeof(index));
+            _sections.terminal = _section(a_header.terminal_count * sizeof(index));
+            _sections.order = _section(a_header.order_count * sizeof(index));
+            _sections.earliest = _section(a_header.has_times ? a_header.event_count * sizeof(duration) : 0);
+            _sections.latest = _section(a_header.has_times ? a_header.event_count * sizeof(duration) : 0);
+            _sections.size = _offset;
+            return _sections;
+        };
+
+        /// @brief Tag the kind of a stored type, so that e.g. int and float of the same size are told apart
+        template<typename T>
+        static constexpr std::uint32_t type_tag()
+        {
+            return std::is_floating_point_v<T> ? 3 : std::is_signed_v<T> ? 2 : std::is_integral_v<T> ? 1 : 0;
+        };
+
+        /// @brief Checksum of the payload, eight bytes at a time
+        static std::uint64_t checksum(const char* some_bytes, std::size_t a_size)
+        {
+            std::uint64_t _hash = 0xCBF29CE484222325ULL;
+            for (std::size_t i = 0; i + 8 <= a_size; i += 8)
+            {
+                std::uint64_t _word;
+                std::memcpy(&_word, some_bytes + i, sizeof(_word));
+                _hash = (_hash ^ _word) * 0x100000001B3ULL;
+                _hash ^= _hash >> 29;
+            }
+            return _hash ^ a_size;
+        };
+
+        /// @brief View a payload section as an array
+        template<typename T>
+        const T* array(std::size_t an_offset) const
+        {
+            return reinterpret_cast<const T*>(__payload + an_offset);
+        };
+
+        const duration* times(std::size_t an_offset) const
+        {
+            if (not has_times())
+                throw std::logic_error("snapshot holds no event times");
+            return array<duration>(an_offset);
+        };
+
+        static index checked(index an_index)
+        {
+            if (an_index == npos)
+                throw std::out_of_range("not in the snapshot");
+            return an_index;
+        };
+
+        std::vector<event> events_of(std::size_t an_offset, std::size_t a_count) const
+        {
+            std::vector<event> _events;
+            for (std::size_t i = 0; i < a_count; ++i)
+                _events.push_back(events()[array<index>(an_offset)[i]]);
+            return _events;
+        };
+
+    // data members
+    private:
+        memory_map __map;
+        header __header;
+        sections __sections;
+        const char* __payload;
+
+    };
+
+} // namespace pert
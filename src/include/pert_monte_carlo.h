@@ -0,0 +1,368 @@
+/***
+ * @brief This file describes a Monte Carlo engine that simulates activity networks with three point duration estimates.
+ * @author Johann Fotsing
+ * @date 2026-10-16
+ * @file pert_monte_carlo.h
+ */
+
+#pragma once
+
+#include <pert.h>
+#include <pert_batch.h>
+#include <pert_thread_pool.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+
+namespace pert
+{
+
+    /**
+     * @brief Counter based random stream.
+     * The n-th number of a stream only depends on the stream key and on n, so that any sample of a simulation
+     * can be drawn by any thread and simulations are reproducible whatever the number of threads.
+     *
+     */
+    class random_stream
+    {
+
+    public:
+        /// @brief Open the stream of a sample
+        /// @param a_seed simulation seed
+        /// @param a_stream stream number (the sample number)
+        random_stream(std::uint64_t a_seed, std::uint64_t a_stream) : __key(mix(a_seed ^ mix(a_stream + __golden))), __counter(0) {}
+
+        /// @brief Move to a position of the stream, e.g. to the sub-stream of an activity
+        /// @param a_counter position in the stream
+        void seek(std::uint64_t a_counter) { __counter = a_counter; }
+
+        /// @brief Get the next 64 random bits of the stream
+        std::uint64_t next() { return mix(__key + (++__counter) * __golden); }
+
+        /// @brief Get a uniform number in [0, 1)
+        double uniform() { return static_cast<double>(next() >> 11) * 0x1.0p-53; }
+
+    private:
+        static constexpr std::uint64_t __golden = 0x9E3779B97F4A7C15ULL;
+
+        /// @brief splitmix64 finalizer
+        static std::uint64_t mix(std::uint64_t z)
+        {
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        }
+
+    private:
+        std::uint64_t __key;
+        std::uint64_t __counter;
+    };
+
+    /**
+     * @brief This class runs Monte Carlo simulations of an activity network.
+     * Each sample draws every activity duration from its three point estimate, then runs the forward pass
+     * (and the backward pass for criticality) on the network's compiled adjacency. Samples are spread over threads.
+     *
+     * @tparam EventIDType type of the network's event objects
+     * @tparam DurationType type of the network's duration objects, convertible to and from double
+     */
+    template<typename EventIDType, typename DurationType>
+    class monte_carlo
+    {
+
+    public:
+
+        /// @brief context types
+        using network_type = network<EventIDType, DurationType>;
+        using activity = typename network_type::activity;
+        using adjacency = typename network_type::adjacency;
+        using index = typename adjacency::index;
+
+        /// @brief Simulation settings
+        struct options
+        {
+            std::size_t samples = 10000;
+            std::uint64_t seed = 0;
+            unsigned threads = 0;               ///< 0 uses every hardware thread
+            bool criticality = true;            ///< run the backward pass to compute criticality indices
+        };
+
+        /// @brief Simulation results
+        struct result
+        {
+            std::size_t samples = 0;
+            double mean = 0.;
+            double variance = 0.;
+            double on_time_probability = 0.;    ///< probability of completing no later than the network's terminal time
+            std::vector<double> completion_times;   ///< sampled completion times, sorted
+            std::vector<activity> activities;       ///< simulated activities
+            std::vector<double> criticality;        ///< fraction of samples in which each activity is critical
+
+            /// @brief Get a percentile of the completion time distribution
+            /// @param a_percentile percentile in [0, 100]
+            /// @return the completion time, interpolated between samples
+            double percentile(double a_percentile) const
+            {
+                if (completion_times.empty())
+                    return 0.;
+                const double _rank = std::clamp(a_percentile, 0., 100.) / 100. * static_cast<double>(completion_times.size() - 1);
+                const std::size_t _below = static_cast<std::size_t>(_rank);
+                const std::size_t _above = std::min(_below + 1, completion_times.size() - 1);
+                return completion_times[_below] + (_rank - static_cast<double>(_below)) * (completion_times[_above] - completion_times[_below]);
+            }
+        };
+
+    public:
+
+        /// @brief Prepare the simulation of a network.
+        ///        The network must outlive the simulation object and must not be modified while it is used.
+        /// @param a_network a well formed network
+        monte_carlo(const network_type& a_network) : __network(a_network), __adjacency(a_network.compiled())
+        {
+            if (not __adjacency.acyclic())
+                throw std::logic_error("network contains a loop");
+            if (__adjacency.link_count() > 0)
+                throw std::invalid_argument("simulations do not support precedence constraints");
+
+            __laws.reserve(__adjacency.activity_count());
+            for (const auto& a: __adjacency.activities)
+                __laws.emplace_back(a_network.get_estimate(a));
+        };
+
+        /// @brief Run a simulation
+        /// @param some_options simulation settings
+        /// @return the completion time distribution and the activities' criticality indices
+        result run(const options& some_options) const
+        {
+            result _result;
+            _result.samples = some_options.samples;
+            _result.completion_times.resize(some_options.samples);
+            _result.activities.assign(__adjacency.activities.cbegin(), __adjacency.activities.cend());
+
+            // contiguous blocks of samples per thread
+            unsigned _thread_count = some_options.threads > 0 ? some_options.threads : std::max(1u, std::thread::hardware_concurrency());
+            _thread_count = static_cast<unsigned>(std::max<std::size_t>(1, std::min<std::size_t>(_thread_count, some_options.samples)));
+            std::vector<std::vector<std::uint64_t>> _critical_counts(_thread_count);
+            thread_pool _pool(_thread_count);
+            _pool.parallel_for(_thread_count, [this, &some_options, &_result, &_critical_counts, _thread_count](std::size_t t)
+            {
+                const std::size_t _first = some_options.samples * t / _thread_count;
+                const std::size_t _last = some_options.samples * (t + 1) / _thread_count;
+                simulate(some_options, _first, _last, _result.completion_times, _critical_counts[t]);
+            });
+
+            // statistics, in sample order so that they do not depend on the number of threads
+            const double _terminal_time = static_cast<double>(__network.terminal_time());
+            std::size_t _on_time = 0;
+            double _sum = 0.;
+            for (const double c: _result.completion_times)
+            {
+                _sum += c;
+                _on_time += c <= _terminal_time ? 1 : 0;
+            }
+            const double _count = static_cast<double>(std::max<std::size_t>(1, some_options.samples));
+            _result.mean = _sum / _count;
+            double _squares = 0.;
+            for (const double c: _result.completion_times)
+                _squares += (c - _result.mean) * (c - _result.mean);
+            _result.variance = some_options.samples > 1 ? _squares / (_count - 1.) : 0.;
+            _result.on_time_probability = static_cast<double>(_on_time) / _count;
+            std::sort(_result.completion_times.begin(), _result.completion_times.end());
+
+            _result.criticality.assign(__adjacency.activity_count(), 0.);
+            if (some_options.criticality)
+            {
+                for (index a = 0; a < __adjacency.activity_count(); ++a)
+                {
+                    std::uint64_t _critical = 0;
+                    for (const auto& counts: _critical_counts)
+                        _critical += counts[a];
+                    _result.criticality[a] = static_cast<double>(_critical) / _count;
+                }
+            }
+            return _result;
+        };
+
+    private:
+
+        /// @brief Sampling parameters of an activity duration
+        struct law
+        {
+            distribution kind;
+            double optimistic;
+            double most_likely;
+            double pessimistic;
+            double alpha;           ///< beta-PERT shape parameters
+            double beta;
+            double cheng_b;         ///< constants of Cheng's BB beta sampler
+            double cheng_gamma;
+
+            law(const typename network_type::estimate& an_estimate) :
+                kind(an_estimate.law),
+                optimistic(static_cast<double>(an_estimate.optimistic)),
+                most_likely(static_cast<double>(an_estimate.most_likely)),
+                pessimistic(static_cast<double>(an_estimate.pessimistic)),
+                alpha(1.), beta(1.), cheng_b(0.), cheng_gamma(0.)
+            {
+                const double _range = pessimistic - optimistic;
+                if (_range > 0.)
+                {
+                    alpha = 1. + 4. * (most_likely - optimistic) / _range;
+                    beta = 1. + 4. * (pessimistic - most_likely) / _range;
+                }
+                if (alpha > 1. and beta > 1.)
+                {
+                    cheng_b = std::sqrt((alpha + beta - 2.) / (2. * alpha * beta - alpha - beta));
+                    cheng_gamma = alpha + 1. / cheng_b;
+                }
+            }
+
+            double sample(random_stream& a_stream) const
+            {
+                const double _range = pessimistic - optimistic;
+                if (not (_range > 0.))
+                    return most_likely;
+                switch (kind)
+                {
+                case distribution::beta_pert:
+                    return optimistic + _range * sample_beta(a_stream);
+                case distribution::triangular:
+                {
+                    // inverse cumulative distribution
+                    const double u = a_stream.uniform();
+                    const double _mode = (most_likely - optimistic) / _range;
+                    if (u < _mode)
+                        return optimistic + std::sqrt(u * _range * (most_likely - optimistic));
+                    return pessimistic - std::sqrt((1. - u) * _range * (pessimistic - most_likely));
+                }
+                default:
+                    return optimistic + _range * a_stream.uniform();
+                }
+            }
+
+            /// @brief Draw a beta(alpha, beta) number: Cheng's BB rejection algorithm, or the inverse cumulative distribution when a shape is 1
+            double sample_beta(random_stream& a_stream) const
+            {
+                if (alpha <= 1.)
+                    return 1. - std::pow(1. - a_stream.uniform(), 1. / beta);
+                if (beta <= 1.)
+                    return std::pow(a_stream.uniform(), 1. / alpha);
+
+                const double _sum = alpha + beta;
+                while (true)
+                {
+                    const double u1 = 1. - a_stream.uniform();
+                    const double u2 = a_stream.uniform();
+                    if (u1 >= 1.)
+                        continue;
+                    const double v = cheng_b * std::log(u1 / (1. - u1));
+                    const double w = alpha * std::exp(v);
+                    const double z = u1 * u1 * u2;
+                    const double r = cheng_gamma * v - 1.3862943611198906;
+                    const double _s = alpha + r - w;
+                    if (_s + 2.6094379124341003 >= 5. * z)
+                        return w / (beta + w);
+                    const double t = std::log(z);
+                    if (_s > t or r + _sum * std::log(_sum / (beta + w)) >= t)
+                        return w / (beta + w);
+                }
+            }
+        };
+
+        /// @brief Simulate a block of samples
+        /// @param some_options simulation settings
+        /// @param a_first first sample of the block
+        /// @param a_last past-the-end sample of the block
+        /// @param some_completion_times completion time by sample (the block's entries are written)
+        /// @param some_critical_counts number of samples in which each activity is critical (filled)
+        void simulate(const options& some_options, std::size_t a_first, std::size_t a_last, std::vector<double>& some_completion_times, std::vector<std::uint64_t>& some_critical_counts) const
+        {
+            const std::size_t _activity_count = __adjacency.activity_count();
+            const double _initial_time = static_cast<double>(__network.initial_time());
+            std::vector<double> _durations(_activity_count);
+            std::vector<double> _earliest(__adjacency.event_count());
+            std::vector<double> _latest(__adjacency.event_count());
+            some_critical_counts.assign(_activity_count, 0);
+
+            // without criticality only the forward pass is needed: run it on batches of samples
+            if (not some_options.criticality)
+            {
+                batch_forward_pass<EventIDType, DurationType, 16, double> _batch(__network);
+                for (std::size_t s = a_first; s < a_last; s += _batch.lanes)
+                {
+                    const std::size_t _lanes = std::min(_batch.lanes, a_last - s);
+                    for (std::size_t l = 0; l < _lanes; ++l)
+                    {
+                        random_stream _stream(some_options.seed, s + l);
+                        for (index a = 0; a < _activity_count; ++a)
+                        {
+                            _stream.seek(static_cast<std::uint64_t>(a) << 32);
+                            _batch.durations(a)[l] = __laws[a].sample(_stream);
+                        }
+                    }
+                    _batch.run();
+                    for (std::size_t l = 0; l < _lanes; ++l)
+                        some_completion_times[s + l] = _batch.completion(l);
+                }
+                return;
+            }
+
+            for (std::size_t s = a_first; s < a_last; ++s)
+            {
+                // one sub-stream per activity, so that a draw does not depend on the draws before it
+                random_stream _stream(some_options.seed, s);
+                for (index a = 0; a < _activity_count; ++a)
+                {
+                    _stream.seek(static_cast<std::uint64_t>(a) << 32);
+                    _durations[a] = __laws[a].sample(_stream);
+                }
+
+                // - forward pass
+                double _completion = _initial_time;
+                for (const index e: __adjacency.order)
+                {
+                    double _time = _initial_time;
+                    const index* _first = __adjacency.in_begin(e);
+                    const index* _last = __adjacency.in_end(e);
+                    if (_first != _last)
+                    {
+                        _time = _earliest[__adjacency.triggers[*_first]] + _durations[*_first];
+                        for (++_first; _first != _last; ++_first)
+                            _time = std::max(_time, _earliest[__adjacency.triggers[*_first]] + _durations[*_first]);
+                    }
+                    _earliest[e] = _time;
+                    _completion = std::max(_completion, _time);
+                }
+                some_completion_times[s] = _completion;
+
+                // - backward pass against the sample's own completion time
+                for (auto it = __adjacency.order.crbegin(); it != __adjacency.order.crend(); ++it)
+                {
+                    const index e = *it;
+                    double _time = _completion;
+                    for (index a = __adjacency.out_begin(e); a != __adjacency.out_end(e); ++a)
+                        _time = std::min(_time, _latest[__adjacency.completions[a]] - _durations[a]);
+                    _latest[e] = _time;
+                }
+
+                // critical activities have no total float (up to rounding)
+                const double _tolerance = 1e-9 * std::max(1., std::abs(_completion));
+                for (index a = 0; a < _activity_count; ++a)
+                {
+                    const double _float = _latest[__adjacency.completions[a]] - _earliest[__adjacency.triggers[a]] - _durations[a];
+                    if (_float <= _tolerance)
+                        ++some_critical_counts[a];
+                }
+            }
+        };
+
+    // data members
+    private:
+        const network_type& __network;
+        const adjacency& __adjacency;
+        std::vector<law> __laws;
+
+    };
+
+} // namespace pert
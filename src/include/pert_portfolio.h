@@ -0,0 +1,248 @@
+/***
+ * @brief This file describes a portfolio evaluator which loads, validates and schedules many networks concurrently.
+ * @author Johann Fotsing
+ * @date 2026-10-16
+ * @file pert_portfolio.h
+ */
+
+#pragma once
+
+#include <pert.h>
+#include <pert_io.h>
+#include <pert_thread_pool.h>
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace pert
+{
+
+    /**
+     * @brief This class analyses a portfolio of networks, given as files or in memory, one task per network on a
+     * work-stealing thread pool. Reports are streamed to a callback as networks finish, in completion order.
+     *
+     * @tparam EventIDType type of the networks' event objects
+     * @tparam DurationType type of the networks' duration objects
+     */
+    template<typename EventIDType, typename DurationType>
+    class portfolio
+    {
+
+    public:
+
+        /// @brief context types
+        using network_type = network<EventIDType, DurationType>;
+        using event = EventIDType;
+        using duration = DurationType;
+
+        /// @brief Analysis of one network of the portfolio
+        struct report
+        {
+            std::size_t position = 0;           ///< position of the network in the portfolio
+            std::string name;                   ///< file name, or "#position" for networks in memory
+            bool ok = false;                    ///< false if the network could not be loaded or has a loop
+            std::string error;
+            bool well_formed = false;           ///< one initial event, one terminal event and no loop
+            std::size_t events = 0;
+            std::size_t activities = 0;
+            duration completion {};             ///< latest earliest occurence of the terminal events
+            std::vector<event> critical_path;   ///< events of a critical path
+            std::size_t critical_activities = 0;///< activities without total float
+            duration min_float {};              ///< smallest, mean and largest total float of the activities
+            double mean_float = 0.;
+            duration max_float {};
+            double seconds = 0.;                ///< wall time of the network's load and analysis
+
+            /// @brief Get the report as a one line JSON object
+            std::string to_json() const
+            {
+                std::string _json = "{\"position\": ";
+                append_json(_json, position);
+                _json += ", \"network\": ";
+                append_json_string(_json, name);
+                _json += ", \"ok\": ";
+                _json += ok ? "true" : "false";
+                if (not ok)
+                {
+                    _json += ", \"error\": ";
+                    append_json_string(_json, error);
+                }
+                else
+                {
+                    _json += ", \"well_formed\": ";
+                    _json += well_formed ? "true" : "false";
+                    _json += ", \"events\": ";
+                    append_json(_json, events);
+                    _json += ", \"activities\": ";
+                    append_json(_json, activities);
+                    _json += ", \"completion\": ";
+                    append_json(_json, completion);
+                    _json += ", \"critical_path\": [";
+                    for (std::size_t i = 0; i < critical_path.size(); ++i)
+                    {
+                        _json += i > 0 ? ", " : "";
+                        append_json(_json, critical_path[i]);
+                    }
+                    _json += "], \"floats\": {\"critical\": ";
+                    append_json(_json, critical_activities);
+                    _json += ", \"min\": ";
+                    append_json(_json, min_float);
+                    _json += ", \"mean\": ";
+                    append_json(_json, mean_float);
+                    _json += ", \"max\": ";
+                    append_json(_json, max_float);
+                    _json += "}";
+                }
+                _json += ", \"seconds\": ";
+                append_json(_json, seconds);
+                _json += "}";
+                return _json;
+            }
+        };
+
+    public:
+
+        /// @brief Start the evaluator's thread pool
+        /// @param a_thread_count number of threads, 0 uses every hardware thread
+        explicit portfolio(unsigned a_thread_count = 0) : __pool(a_thread_count) {};
+
+        /// @brief Get the number of threads analysing networks
+        unsigned threads() const
+        {
+            return __pool.size();
+        };
+
+        /// @brief Load and analyse network description files
+        /// @param some_files file names
+        /// @param a_callback called with each report as soon as it is ready, one call at a time
+        template<typename Callback>
+        void evaluate_files(const std::vector<std::string>& some_files, const Callback& a_callback)
+        {
+            run(some_files.size(), a_callback, [&some_files](std::size_t i, report& a_report)
+            {
+                a_report.name = some_files[i];
+                analyse(load_txt<EventIDType, DurationType>(some_files[i], 1), a_report);
+            });
+        };
+
+        /// @brief Load and analyse network description files
+        /// @param some_files file names
+        /// @return the reports, in file order
+        std::vector<report> evaluate_files(const std::vector<std::string>& some_files)
+        {
+            return collect(some_files.size(), [this, &some_files](const auto& a_callback) { evaluate_files(some_files, a_callback); });
+        };
+
+        /// @brief Analyse networks in memory. A network must not be shared with other threads during the evaluation.
+        /// @param some_networks networks
+        /// @param a_callback called with each report as soon as it is ready, one call at a time
+        template<typename Callback>
+        void evaluate(const std::vector<network_type>& some_networks, const Callback& a_callback)
+        {
+            run(some_networks.size(), a_callback, [&some_networks](std::size_t i, report& a_report)
+            {
+                a_report.name = "#" + std::to_string(i);
+                analyse(some_networks[i], a_report);
+            });
+        };
+
+        /// @brief Analyse networks in memory
+        /// @param some_networks networks
+        /// @return the reports, in network order
+        std::vector<report> evaluate(const std::vector<network_type>& some_networks)
+        {
+            return collect(some_networks.size(), [this, &some_networks](const auto& a_callback) { evaluate(some_networks, a_callback); });
+        };
+
+        /// @brief Validate and schedule a network
+        /// @param a_network network
+        /// @param a_report report to fill
+        static void analyse(const network_type& a_network, report& a_report)
+        {
+            const auto& _adjacency = a_network.compiled();
+            a_report.events = _adjacency.event_count();
+            a_report.activities = _adjacency.activity_count();
+            if (not _adjacency.acyclic())
+                throw std::logic_error("network contains a loop");
+            a_report.well_formed = _adjacency.initial.size() == 1 and _adjacency.terminal.size() == 1;
+
+            const auto& _times = a_network.times();
+            a_report.completion = a_network.initial_time();
+            for (const auto e: _adjacency.terminal)
+                a_report.completion = std::max(a_report.completion, _times.earliest[e]);
+
+            const auto _path = a_network.find_critical_path();
+            for (const auto& s: _path)
+                a_report.critical_path.push_back(s.first.trigger_event());
+            if (not _path.empty())
+                a_report.critical_path.push_back(_path.back().first.completion_event());
+
+            const auto _floats = a_network.floats();
+            double _sum = 0.;
+            for (std::size_t a = 0; a < _floats.activity_float.size(); ++a)
+            {
+                const duration f = _floats.activity_float[a];
+                a_report.min_float = a == 0 ? f : std::min(a_report.min_float, f);
+                a_report.max_float = a == 0 ? f : std::max(a_report.max_float, f);
+                a_report.critical_activities += f == duration(0) ? 1 : 0;
+                _sum += static_cast<double>(f);
+            }
+            a_report.mean_float = _floats.activity_float.empty() ? 0. : _sum / static_cast<double>(_floats.activity_float.size());
+            a_report.ok = true;
+        };
+
+    private:
+
+        /// @brief Run one analysis task per network and hand the reports to a callback
+        template<typename Callback, typename Analysis>
+        void run(std::size_t a_count, const Callback& a_callback, const Analysis& an_analysis)
+        {
+            std::mutex _output;
+            std::vector<std::future<void>> _futures;
+            _futures.reserve(a_count);
+            for (std::size_t i = 0; i < a_count; ++i)
+            {
+                _futures.push_back(__pool.submit([i, &_output, &a_callback, &an_analysis]()
+                {
+                    const auto _start = std::chrono::steady_clock::now();
+                    report _report;
+                    _report.position = i;
+                    try
+                    {
+                        an_analysis(i, _report);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        _report.ok = false;
+                        _report.error = e.what();
+                    }
+                    _report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - _start).count();
+                    std::lock_guard<std::mutex> _lock(_output);
+                    a_callback(_report);
+                }));
+            }
+            for (auto& f: _futures)
+                __pool.wait(f);
+            for (auto& f: _futures)
+                f.get();
+        };
+
+        /// @brief Collect the reports of an evaluation in portfolio order
+        template<typename Evaluation>
+        static std::vector<report> collect(std::size_t a_count, const Evaluation& an_evaluation)
+        {
+            std::vector<report> _reports(a_count);
+            an_evaluation([&_reports](const report& a_report) { _reports[a_report.position] = a_report; });
+            return _reports;
+        };
+
+    // data members
+    private:
+        thread_pool __pool;
+
+    };
+
+} // namespace pert
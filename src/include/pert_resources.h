@@ -0,0 +1,538 @@
+/***
+ * @brief This file describes resource constrained scheduling of activity networks with priority rule based schedule generation schemes.
+ * @author Johann Fotsing
+ * @date 2026-10-16
+ * @file pert_resources.h
+ */
+
+#pragma once
+
+#include <pert.h>
+#include <pert_thread_pool.h>
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace pert
+{
+
+    /// @brief Schedule generation schemes
+    enum class generation_scheme
+    {
+        serial,         ///< activities in priority order, each at its earliest precedence and resource feasible start
+        parallel        ///< time steps, starting the eligible activities in priority order while resources last
+    };
+
+    /// @brief Priority rules of the schedule generation schemes, ties are broken by activity index or at random
+    enum class priority_rule
+    {
+        latest_finish,              ///< smallest unconstrained latest finish first (LFT)
+        latest_start,               ///< smallest unconstrained latest start first (LST)
+        minimum_slack,              ///< smallest total float first (MSLK)
+        most_successors,            ///< most immediate successors first (MIS)
+        greatest_rank_weight,       ///< greatest duration plus immediate successors' durations first (GRPW)
+        greatest_resource_demand,   ///< greatest duration times relative resource demand first (GRD)
+        shortest_duration,          ///< shortest duration first (SPT)
+        earliest_start,             ///< smallest unconstrained earliest start first (EST)
+        random                      ///< tie breaks only
+    };
+
+    /**
+     * @brief This class schedules the activities of a network under renewable resource capacities.
+     * Activities declare how many units of each resource they hold while they run. The scheduler builds schedules
+     * with the serial and parallel generation schemes driven by priority rules computed from the network's
+     * unconstrained times, evaluates rules and randomised tie breaks concurrently, and keeps the shortest schedule.
+     *
+     * @tparam EventIDType type of the network's event objects
+     * @tparam DurationType type of the network's duration objects, convertible to double
+     */
+    template<typename EventIDType, typename DurationType>
+    class resource_scheduler
+    {
+
+    public:
+
+        /// @brief context types
+        using network_type = network<EventIDType, DurationType>;
+        using activity = typename network_type::activity;
+        using duration = DurationType;
+        using adjacency = typename network_type::adjacency;
+        using index = typename adjacency::index;
+        using resource = std::size_t;
+        using quantity = std::int64_t;
+
+        /// @brief Scheduling settings
+        struct options
+        {
+            std::vector<priority_rule> rules = { priority_rule::latest_finish, priority_rule::latest_start, priority_rule::minimum_slack,
+                                                 priority_rule::most_successors, priority_rule::greatest_rank_weight, priority_rule::greatest_resource_demand,
+                                                 priority_rule::shortest_duration, priority_rule::earliest_start };
+            std::vector<generation_scheme> schemes = { generation_scheme::serial, generation_scheme::parallel };
+            std::size_t samples = 4;            ///< schedules per rule and scheme: the first breaks ties by activity index, the others at random
+            std::uint64_t seed = 0;
+            unsigned threads = 0;               ///< 0 uses every hardware thread
+        };
+
+        /// @brief A resource feasible schedule
+        struct result
+        {
+            duration completion {};             ///< latest finish of the activities, or the network's initial time
+            std::vector<activity> activities;   ///< scheduled activities
+            std::vector<duration> starts;       ///< start time by activity
+            std::vector<duration> finishes;     ///< finish time by activity
+            priority_rule rule = priority_rule::latest_finish;
+            generation_scheme scheme = generation_scheme::serial;
+            std::size_t sample = 0;             ///< sample of the rule and scheme which built the schedule
+            std::size_t evaluated = 0;          ///< number of schedules built to find this one
+
+            /// @brief Get the start time of an activity
+            /// @param an_activity scheduled activity
+            duration start(const activity& an_activity) const
+            {
+                auto search = std::lower_bound(activities.cbegin(), activities.cend(), an_activity);
+                if (search == activities.cend() or not (*search == an_activity))
+                    throw std::out_of_range("activity is not in the schedule");
+                return starts[search - activities.cbegin()];
+            }
+        };
+
+    public:
+
+        /// @brief Prepare resource constrained scheduling of a network.
+        ///        The network must outlive the scheduler and must not be modified while it is used.
+        /// @param a_network a well formed network
+        resource_scheduler(const network_type& a_network) : __network(a_network), __adjacency(a_network.compiled()), __demands(__adjacency.activity_count())
+        {
+            if (not __adjacency.acyclic())
+                throw std::logic_error("network contains a loop");
+            if (__adjacency.link_count() > 0)
+                throw std::invalid_argument("resource scheduling does not support precedence constraints");
+
+            // priority rules read the unconstrained times from several threads: compute them now
+            a_network.times();
+        };
+
+        /// @brief Declare a resource pool
+        /// @param a_name resource name
+        /// @param a_capacity number of units available at any time
+        /// @return the resource number
+        resource add_resource(const std::string& a_name, quantity a_capacity)
+        {
+            if (a_capacity < 0)
+                throw std::invalid_argument("negative capacity of resource " + a_name);
+            __names.push_back(a_name);
+            __capacities.push_back(a_capacity);
+            return __capacities.size() - 1;
+        };
+
+        /// @brief Get the number of resource pools
+        std::size_t resource_count() const
+        {
+            return __capacities.size();
+        };
+
+        /// @brief Get the name of a resource pool
+        const std::string& resource_name(resource a_resource) const
+        {
+            return __names.at(a_resource);
+        };
+
+        /// @brief Get the capacity of a resource pool
+        quantity capacity(resource a_resource) const
+        {
+            return __capacities.at(a_resource);
+        };
+
+        /// @brief Set the number of units of a resource held by an activity while it runs
+        /// @param an_activity activity of the network
+        /// @param a_resource resource number
+        /// @param an_amount number of units, 0 removes the demand
+        /// @return a reference to the scheduler
+        resource_scheduler& set_demand(const activity& an_activity, resource a_resource, quantity an_amount)
+        {
+            const index a = checked_activity(an_activity);
+            if (a_resource >= __capacities.size())
+                throw std::out_of_range("unknown resource " + std::to_string(a_resource));
+            if (an_amount < 0 or an_amount > __capacities[a_resource])
+                throw std::invalid_argument("demand exceeds the capacity of resource " + __names[a_resource]);
+
+            auto& _demands = __demands[a];
+            auto search = std::find_if(_demands.begin(), _demands.end(), [a_resource](const auto& d) { return d.first == a_resource; });
+            if (search != _demands.end())
+                _demands.erase(search);
+            if (an_amount > 0)
+                _demands.emplace_back(a_resource, an_amount);
+            return *this;
+        };
+
+        /// @brief Get the number of units of a resource held by an activity while it runs
+        quantity demand(const activity& an_activity, resource a_resource) const
+        {
+            for (const auto& d: __demands[checked_activity(an_activity)])
+                if (d.first == a_resource)
+                    return d.second;
+            return 0;
+        };
+
+        /// @brief Build one schedule
+        /// @param a_rule priority rule
+        /// @param a_scheme schedule generation scheme
+        /// @param a_seed 0 breaks ties by activity index, other values at random
+        /// @return a resource feasible schedule
+        result schedule(priority_rule a_rule, generation_scheme a_scheme, std::uint64_t a_seed = 0) const
+        {
+            result _result;
+            _result.rule = a_rule;
+            _result.scheme = a_scheme;
+            _result.evaluated = 1;
+            _result.activities.assign(__adjacency.activities.cbegin(), __adjacency.activities.cend());
+            _result.starts.resize(__adjacency.activity_count());
+            _result.finishes.resize(__adjacency.activity_count());
+            const std::vector<key> _keys = keys(priorities(a_rule), a_seed);
+            _result.completion = a_scheme == generation_scheme::serial ? serial(_keys, _result.starts, _result.finishes) : parallel(_keys, _result.starts, _result.finishes);
+            return _result;
+        };
+
+        /// @brief Build schedules for every rule, scheme and sample of the options, concurrently, and keep the shortest
+        /// @param some_options scheduling settings
+        /// @return the schedule with the earliest completion, the first one in (scheme, rule, sample) order on ties
+        result schedule(const options& some_options) const
+        {
+            // runs in (scheme, rule, sample) order, so that the winner does not depend on the number of threads
+            struct run
+            {
+                generation_scheme scheme;
+                priority_rule rule;
+                std::size_t sample;
+            };
+            std::vector<run> _runs;
+            for (const auto s: some_options.schemes)
+                for (const auto r: some_options.rules)
+                    for (std::size_t k = 0; k < std::max<std::size_t>(1, some_options.samples); ++k)
+                        _runs.push_back({ s, r, k });
+            if (_runs.empty())
+                throw std::invalid_argument("no priority rule or generation scheme to evaluate");
+
+            // only completion times are kept, the best schedule is rebuilt afterwards
+            std::vector<duration> _completions(_runs.size());
+            thread_pool _pool(std::min<unsigned>(some_options.threads > 0 ? some_options.threads : std::max(1u, std::thread::hardware_concurrency()),
+                                                 static_cast<unsigned>(_runs.size())));
+            _pool.parallel_for(_runs.size(), [&](std::size_t i)
+            {
+                std::vector<duration> _starts(__adjacency.activity_count()), _finishes(__adjacency.activity_count());
+                const std::vector<key> _keys = keys(priorities(_runs[i].rule), seed(some_options.seed, i, _runs[i].sample));
+                _completions[i] = _runs[i].scheme == generation_scheme::serial ? serial(_keys, _starts, _finishes) : parallel(_keys, _starts, _finishes);
+            });
+
+            const std::size_t _best = std::min_element(_completions.cbegin(), _completions.cend()) - _completions.cbegin();
+            result _result = schedule(_runs[_best].rule, _runs[_best].scheme, seed(some_options.seed, _best, _runs[_best].sample));
+            _result.sample = _runs[_best].sample;
+            _result.evaluated = _runs.size();
+            return _result;
+        };
+
+    private:
+
+        /// @brief Priority of an activity: smallest first, then by tie break
+        struct key
+        {
+            double priority;
+            std::uint64_t tie;
+
+            bool operator<(const key& another) const
+            {
+                return priority < another.priority or (priority == another.priority and tie < another.tie);
+            }
+        };
+
+        /// @brief Usage of a resource over time: the entry (t, u) holds u units from t to the next entry
+        using profile = std::map<duration, quantity>;
+
+        /// @brief Get the activity index of an activity, throw if it is not in the network
+        index checked_activity(const activity& an_activity) const
+        {
+            const index a = __adjacency.activity_index(an_activity);
+            if (a == adjacency::npos)
+                throw std::out_of_range("activity is not in the network");
+            return a;
+        };
+
+        /// @brief Get the seed of a run, 0 for the first sample of a rule and scheme
+        static std::uint64_t seed(std::uint64_t a_seed, std::size_t a_run, std::size_t a_sample)
+        {
+            if (a_sample == 0)
+                return 0;
+            std::uint64_t z = a_seed + (a_run + 1) * 0x9E3779B97F4A7C15ULL;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return (z ^ (z >> 31)) | 1;
+        };
+
+        /// @brief Compute the priority value of every activity under a rule, smallest first
+        std::vector<double> priorities(priority_rule a_rule) const
+        {
+            const auto& _times = __network.times();
+            std::vector<double> _priorities(__adjacency.activity_count(), 0.);
+            for (index a = 0; a < __adjacency.activity_count(); ++a)
+            {
+                const double d = static_cast<double>(__adjacency.durations[a]);
+                const double _earliest = static_cast<double>(_times.earliest[__adjacency.triggers[a]]);
+                const double _latest = static_cast<double>(_times.latest[__adjacency.completions[a]]);
+                const index c = __adjacency.completions[a];
+                switch (a_rule)
+                {
+                case priority_rule::latest_finish:
+                    _priorities[a] = _latest;
+                    break;
+                case priority_rule::latest_start:
+                    _priorities[a] = _latest - d;
+                    break;
+                case priority_rule::minimum_slack:
+                    _priorities[a] = _latest - _earliest - d;
+                    break;
+                case priority_rule::most_successors:
+                    _priorities[a] = -static_cast<double>(__adjacency.out_end(c) - __adjacency.out_begin(c));
+                    break;
+                case priority_rule::greatest_rank_weight:
+                {
+                    double _weight = d;
+                    for (index s = __adjacency.out_begin(c); s != __adjacency.out_end(c); ++s)
+                        _weight += static_cast<double>(__adjacency.durations[s]);
+                    _priorities[a] = -_weight;
+                    break;
+                }
+                case priority_rule::greatest_resource_demand:
+                {
+                    double _demand = 0.;
+                    for (const auto& r: __demands[a])
+                        _demand += static_cast<double>(r.second) / static_cast<double>(std::max<quantity>(1, __capacities[r.first]));
+                    _priorities[a] = -d * _demand;
+                    break;
+                }
+                case priority_rule::shortest_duration:
+                    _priorities[a] = d;
+                    break;
+                case priority_rule::earliest_start:
+                    _priorities[a] = _earliest;
+                    break;
+                default:
+                    break;
+                }
+            }
+            return _priorities;
+        };
+
+        /// @brief Attach tie breaks to priorities: activity indices, or random numbers drawn from a seed
+        static std::vector<key> keys(const std::vector<double>& some_priorities, std::uint64_t a_seed)
+        {
+            std::vector<key> _keys(some_priorities.size());
+            std::mt19937_64 _random(a_seed);
+            for (index a = 0; a < _keys.size(); ++a)
+                _keys[a] = { some_priorities[a], a_seed == 0 ? a : _random() };
+            return _keys;
+        };
+
+        /// @brief Serial schedule generation: take the eligible activity of best priority, start it as early as
+        ///        its trigger event and the resource profiles allow
+        duration serial(const std::vector<key>& some_keys, std::vector<duration>& some_starts, std::vector<duration>& some_finishes) const
+        {
+            const duration _initial = __network.initial_time();
+            std::vector<index> _pending(__adjacency.event_count());
+            std::vector<duration> _ready(__adjacency.event_count(), _initial);
+            std::vector<profile> _profiles(__capacities.size(), profile { { _initial, 0 } });
+            auto _later = [&some_keys](index a, index b) { return some_keys[b] < some_keys[a]; };
+            std::vector<index> _eligible;
+            for (index e = 0; e < __adjacency.event_count(); ++e)
+            {
+                _pending[e] = __adjacency.in_end(e) - __adjacency.in_begin(e);
+                if (_pending[e] == 0)
+                    release(e, _eligible, _later);
+            }
+
+            duration _completion = _initial;
+            while (not _eligible.empty())
+            {
+                std::pop_heap(_eligible.begin(), _eligible.end(), _later);
+                const index a = _eligible.back();
+                _eligible.pop_back();
+
+                const duration d = __adjacency.durations[a];
+                duration _start = _ready[__adjacency.triggers[a]];
+                if (d > duration(0))
+                {
+                    // move the start past every overload until a pass over the activity's resources finds none
+                    for (bool _moved = true; _moved;)
+                    {
+                        _moved = false;
+                        for (const auto& r: __demands[a])
+                        {
+                            const duration _free = overload(_profiles[r.first], _start, _start + d, __capacities[r.first] - r.second);
+                            _moved = _moved or _start < _free;
+                            _start = _free;
+                        }
+                    }
+                    for (const auto& r: __demands[a])
+                        reserve(_profiles[r.first], _start, _start + d, r.second);
+                }
+                some_starts[a] = _start;
+                some_finishes[a] = _start + d;
+                _completion = std::max(_completion, some_finishes[a]);
+
+                const index c = __adjacency.completions[a];
+                _ready[c] = std::max(_ready[c], some_finishes[a]);
+                if (--_pending[c] == 0)
+                    release(c, _eligible, _later);
+            }
+            return _completion;
+        };
+
+        /// @brief Parallel schedule generation: at each decision time, start the available activities in priority
+        ///        order while the resources left allow, then move to the next finish or trigger event occurence
+        duration parallel(const std::vector<key>& some_keys, std::vector<duration>& some_starts, std::vector<duration>& some_finishes) const
+        {
+            const duration _initial = __network.initial_time();
+            std::vector<index> _pending(__adjacency.event_count());
+            std::vector<duration> _ready(__adjacency.event_count(), _initial);
+            std::vector<quantity> _left(__capacities);
+            auto _later = [&some_keys](index a, index b) { return some_keys[b] < some_keys[a]; };
+            auto _finishes_later = [&some_finishes](index a, index b) { return some_finishes[b] < some_finishes[a]; };
+            auto _ready_later = [this, &_ready](index a, index b) { return _ready[__adjacency.triggers[b]] < _ready[__adjacency.triggers[a]]; };
+            std::vector<index> _waiting, _available, _deferred, _running;
+            for (index e = 0; e < __adjacency.event_count(); ++e)
+            {
+                _pending[e] = __adjacency.in_end(e) - __adjacency.in_begin(e);
+                if (_pending[e] == 0)
+                    release(e, _waiting, _ready_later);
+            }
+
+            duration _time = _initial;
+            duration _completion = _initial;
+            while (not _waiting.empty() or not _available.empty() or not _running.empty())
+            {
+                // activities whose trigger event has occured become available
+                while (not _waiting.empty() and not (_time < _ready[__adjacency.triggers[_waiting.front()]]))
+                {
+                    std::pop_heap(_waiting.begin(), _waiting.end(), _ready_later);
+                    _available.push_back(_waiting.back());
+                    std::push_heap(_available.begin(), _available.end(), _later);
+                    _waiting.pop_back();
+                }
+
+                // start what fits, in priority order
+                while (not _available.empty())
+                {
+                    std::pop_heap(_available.begin(), _available.end(), _later);
+                    const index a = _available.back();
+                    _available.pop_back();
+                    const bool _fits = std::all_of(__demands[a].cbegin(), __demands[a].cend(), [&_left](const auto& r) { return r.second <= _left[r.first]; });
+                    if (not _fits)
+                    {
+                        _deferred.push_back(a);
+                        continue;
+                    }
+                    some_starts[a] = _time;
+                    some_finishes[a] = _time + __adjacency.durations[a];
+                    for (const auto& r: __demands[a])
+                        _left[r.first] -= r.second;
+                    _running.push_back(a);
+                    std::push_heap(_running.begin(), _running.end(), _finishes_later);
+                }
+                for (const index a: _deferred)
+                {
+                    _available.push_back(a);
+                    std::push_heap(_available.begin(), _available.end(), _later);
+                }
+                _deferred.clear();
+
+                // next decision time: the next finish, or the next trigger event occurence
+                duration _next = _time;
+                bool _found = false;
+                if (not _running.empty())
+                {
+                    _next = some_finishes[_running.front()];
+                    _found = true;
+                }
+                if (not _waiting.empty())
+                {
+                    const duration _occurence = _ready[__adjacency.triggers[_waiting.front()]];
+                    _next = _found ? std::min(_next, _occurence) : _occurence;
+                    _found = true;
+                }
+                if (not _found)
+                    break;
+                _time = std::max(_time, _next);
+
+                // finish the activities due, which releases their resources and may trigger events
+                while (not _running.empty() and not (_time < some_finishes[_running.front()]))
+                {
+                    std::pop_heap(_running.begin(), _running.end(), _finishes_later);
+                    const index a = _running.back();
+                    _running.pop_back();
+                    for (const auto& r: __demands[a])
+                        _left[r.first] += r.second;
+                    _completion = std::max(_completion, some_finishes[a]);
+
+                    const index c = __adjacency.completions[a];
+                    _ready[c] = std::max(_ready[c], some_finishes[a]);
+                    if (--_pending[c] == 0)
+                        release(c, _waiting, _ready_later);
+                }
+            }
+            return _completion;
+        };
+
+        /// @brief Push the outgoing activities of an event which has occured on a heap
+        template<typename Compare>
+        void release(index an_event, std::vector<index>& a_heap, const Compare& a_compare) const
+        {
+            for (index a = __adjacency.out_begin(an_event); a != __adjacency.out_end(an_event); ++a)
+            {
+                a_heap.push_back(a);
+                std::push_heap(a_heap.begin(), a_heap.end(), a_compare);
+            }
+        };
+
+        /// @brief Find where a resource is overloaded in an interval
+        /// @param a_profile resource usage
+        /// @param a_start interval start
+        /// @param a_finish interval end (excluded)
+        /// @param a_limit highest usage allowing the activity to run
+        /// @return a_start if the interval is free, otherwise the end of the first overloaded step (after a_start)
+        static duration overload(const profile& a_profile, const duration& a_start, const duration& a_finish, quantity a_limit)
+        {
+            auto it = std::prev(a_profile.upper_bound(a_start));
+            for (; it != a_profile.cend() and it->first < a_finish; ++it)
+            {
+                if (it->second > a_limit)
+                {
+                    // the last step of a profile is always empty, so an overloaded step has an end
+                    return std::next(it)->first;
+                }
+            }
+            return a_start;
+        };
+
+        /// @brief Add a demand to a resource profile over an interval
+        static void reserve(profile& a_profile, const duration& a_start, const duration& a_finish, quantity an_amount)
+        {
+            auto _first = a_profile.emplace_hint(a_profile.upper_bound(a_start), a_start, std::prev(a_profile.upper_bound(a_start))->second);
+            auto _last = a_profile.emplace_hint(a_profile.upper_bound(a_finish), a_finish, std::prev(a_profile.upper_bound(a_finish))->second);
+            for (; _first != _last; ++_first)
+                _first->second += an_amount;
+        };
+
+    // data members
+    private:
+        const network_type& __network;
+        const adjacency& __adjacency;
+        std::vector<std::vector<std::pair<resource, quantity>>> __demands;     ///< activity index -> (resource, units) pairs
+        std::vector<std::string> __names;
+        std::vector<quantity> __capacities;
+
+    };
+
+} // namespace pert
@@ -0,0 +1,523 @@
+/***
+ * @brief This file describes what-if scenarios: copy-on-write overlays of edits over a shared, immutable network.
+ * @author Johann Fotsing
+ * @date 2026-10-16
+ * @file pert_scenario.h
+ */
+
+#pragma once
+
+#include <pert.h>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace pert
+{
+
+    /**
+     * @brief This class describes a what-if scenario of a network: the base network is shared and never modified,
+     * the scenario only stores its edits (changed durations, deleted and added activities, schedule).
+     * Analyses run on the base's compiled snapshot plus the edits, so a scenario costs memory in proportion to
+     * its edits; the scratch buffers of an analysis live as long as its result. The precedence constraints of the
+     * base are kept, the lags of finish bounds following the durations of their successors in the scenario.
+     * Scenarios of one base can be edited and analysed concurrently, one thread per scenario.
+     *
+     * @tparam EventIDType type of the network's event objects
+     * @tparam DurationType type of the network's duration objects
+     */
+    template<typename EventIDType, typename DurationType>
+    class scenario
+    {
+
+    public:
+
+        /// @brief context types
+        using network_type = network<EventIDType, DurationType>;
+        using event = EventIDType;
+        using duration = DurationType;
+        using activity = typename network_type::activity;
+        using segment = typename network_type::segment;
+        using path = typename network_type::path;
+        using adjacency = typename network_type::adjacency;
+        using index = typename adjacency::index;
+
+        /**
+         * @brief Event times of a scenario, computed once by scenario::analyse.
+         * Events of the base keep their compiled() index, events only used by added activities follow, in value order.
+         *
+         */
+        class analysis
+        {
+
+        public:
+
+            /// @brief Get the earliest occurence time of an event
+            duration earliest_occurence(const event& an_event) const
+            {
+                return __earliest[checked_index(an_event)];
+            };
+
+            /// @brief Get the latest occurence time of an event
+            duration latest_occurence(const event& an_event) const
+            {
+                return __latest[checked_index(an_event)];
+            };
+
+            /// @brief Get the completion time: the latest earliest occurence of the terminal events, or the initial time
+            duration completion() const
+            {
+                duration _completion = __initial_time;
+                for (const index e: __terminal)
+                    _completion = std::max(_completion, __earliest[e]);
+                return _completion;
+            };
+
+            /// @brief Get the float of an activity, as network::activity_float
+            duration activity_float(const activity& an_activity) const
+            {
+                const index a = checked_activity(an_activity);
+                return __earliest[completion_of(a)] - __earliest[trigger_of(a)] - duration_of(a);
+            };
+
+            /// @brief Get the free float of an activity, as network::free_float
+            duration free_float(const activity& an_activity) const
+            {
+                const index a = checked_activity(an_activity);
+                return __latest[completion_of(a)] - __earliest[trigger_of(a)] - duration_of(a);
+            };
+
+            /// @brief Find a critical path, with the ties of network::find_critical_path
+            /// @return list of activity and link segments ordered by precedence, empty if the scenario has no activity
+            path find_critical_path() const
+            {
+                path _critical_path;
+                if (__terminal.empty())
+                    return _critical_path;
+                const index* _last = std::max_element(__terminal.data(), __terminal.data() + __terminal.size(), [this](index e, index f) { return __earliest[e] < __earliest[f]; });
+                for (index e = *_last; ; )
+                {
+                    index _tight = adjacency::npos;
+                    for_each_in(e, [&](index a)
+                    {
+                        if (_tight == adjacency::npos and __earliest[trigger_of(a)] + duration_of(a) == __earliest[e])
+                            _tight = a;
+                    });
+                    if (_tight == adjacency::npos)
+                        break;
+                    _critical_path.push_back(segment_of(_tight));
+                    e = trigger_of(_tight);
+                }
+                std::reverse(_critical_path.begin(), _critical_path.end());
+                return _critical_path;
+            };
+
+        private:
+            friend class scenario;
+
+            /// @brief Run the forward and backward passes of a scenario
+            analysis(const scenario& a_scenario) :
+                __base(a_scenario.__base),
+                __initial_time(a_scenario.initial_time()),
+                __terminal_time(a_scenario.terminal_time())
+            {
+                const adjacency& _adjacency = __base->compiled();
+                const index _base_events = _adjacency.event_count();
+
+                // base durations and lags, and deletions, patched by the scenario
+                __durations.assign(_adjacency.durations.cbegin(), _adjacency.durations.cend());
+                for (const auto& [a, d]: a_scenario.__durations)
+                    __durations[a] = d;
+                __deleted.assign(_adjacency.durations.size(), false);
+                for (const index a: a_scenario.__deleted)
+                    __deleted[a] = true;
+
+                // lags of the finish bounds of edited activities, from their durations in the scenario
+                bool _relinked = false;
+                const auto _duration = [&](const activity& an_activity) -> const duration*
+                {
+                    const index a = _adjacency.activity_index(an_activity);
+                    if (a != adjacency::npos)
+                        return __deleted[a] ? nullptr : &__durations[a];
+                    const auto _search = a_scenario.__added.find(an_activity);
+                    return _search != a_scenario.__added.end() ? &_search->second : nullptr;
+                };
+                const auto _relink = [&](const activity& an_activity)
+                {
+                    for (const auto& [_link, _lag]: __base->finish_bound_lags(an_activity, _duration))
+                    {
+                        const index l = _adjacency.link_index(_link);
+                        // links from an event to itself come and go with the sign of their lag
+                        if (_link.trigger_event() == _link.completion_event() and (l == adjacency::npos) == (duration(0) < _lag))
+                        {
+                            if (l == adjacency::npos)
+                                throw std::logic_error("network contains a loop");
+                            __deleted[l] = true;
+                            _relinked = true;
+                        }
+                        else if (l != adjacency::npos)
+                            __durations[l] = _lag;
+                    }
+                };
+                for (const auto& [a, d]: a_scenario.__durations)
+                    _relink(_adjacency.activities[a]);
+                for (const index a: a_scenario.__deleted)
+                    _relink(_adjacency.activities[a]);
+                for (const auto& [a, d]: a_scenario.__added)
+                    _relink(a);
+
+                // added activities, and the events only they use
+                for (const auto& [a, d]: a_scenario.__added)
+                {
+                    for (const event& e: { a.trigger_event(), a.completion_event() })
+                        if (_adjacency.event_index(e) == adjacency::npos)
+                            __events.push_back(e);
+                }
+                std::sort(__events.begin(), __events.end());
+                __events.erase(std::unique(__events.begin(), __events.end()), __events.end());
+                const index _event_count = _base_events + __events.size();
+                __added_in_offsets.assign(_event_count + 1, 0);
+                __added_out_offsets.assign(_event_count + 1, 0);
+                for (const auto& [a, d]: a_scenario.__added)
+                {
+                    __added.push_back(a);
+                    __added_durations.push_back(d);
+                    __added_triggers.push_back(event_index(a.trigger_event()));
+                    __added_completions.push_back(event_index(a.completion_event()));
+                    ++__added_in_offsets[__added_completions.back() + 1];
+                    ++__added_out_offsets[__added_triggers.back() + 1];
+                }
+                for (index e = 0; e < _event_count; ++e)
+                {
+                    __added_in_offsets[e + 1] += __added_in_offsets[e];
+                    __added_out_offsets[e + 1] += __added_out_offsets[e];
+                }
+                __added_in.resize(__added.size());
+                __added_out.resize(__added.size());
+                {
+                    std::vector<index> _in(__added_in_offsets.cbegin(), __added_in_offsets.cend() - 1);
+                    std::vector<index> _out(__added_out_offsets.cbegin(), __added_out_offsets.cend() - 1);
+                    for (index k = 0; k < __added.size(); ++k)
+                    {
+                        __added_in[_in[__added_completions[k]]++] = k;
+                        __added_out[_out[__added_triggers[k]]++] = k;
+                    }
+                }
+
+                // degrees: events without activity or link left are not part of the scenario
+                std::vector<index> _in_degrees(_event_count, 0), _out_degrees(_event_count, 0);
+                for (index a = 0; a < edge_count(); ++a)
+                {
+                    if (a < __deleted.size() and __deleted[a])
+                        continue;
+                    ++_in_degrees[completion_of(a)];
+                    ++_out_degrees[trigger_of(a)];
+                }
+                for (index e = 0; e < _event_count; ++e)
+                    if (_out_degrees[e] == 0 and _in_degrees[e] > 0)
+                        __terminal.push_back(e);
+
+                // deletions and changed durations keep the base order valid, additions may not
+                // (nor deleted links closing the loops of the base)
+                std::vector<index> _order;
+                if (__added.empty() and not _relinked)
+                {
+                    if (not _adjacency.acyclic())
+                        throw std::logic_error("network contains a loop");
+                    _order.assign(_adjacency.order.cbegin(), _adjacency.order.cend());
+                }
+                else
+                {
+                    _order.reserve(_event_count);
+                    for (index e = 0; e < _event_count; ++e)
+                        if (_in_degrees[e] == 0)
+                            _order.push_back(e);
+                    for (std::size_t i = 0; i < _order.size(); ++i)
+                        for_each_out(_order[i], [&](index a)
+                        {
+                            if (--_in_degrees[completion_of(a)] == 0)
+                                _order.push_back(completion_of(a));
+                        });
+                    if (_order.size() != _event_count)
+                        throw std::logic_error("network contains a loop");
+                }
+
+                // - forward pass, constraints never moving an event before the initial time
+                __earliest.assign(_event_count, __initial_time);
+                for (const index e: _order)
+                {
+                    bool _first = true;
+                    for_each_in(e, [&](index a)
+                    {
+                        const duration _finish = __earliest[trigger_of(a)] + duration_of(a);
+                        __earliest[e] = _first ? _finish : std::max(__earliest[e], _finish);
+                        if (is_link(a))
+                            __earliest[e] = std::max(__earliest[e], __initial_time);
+                        _first = false;
+                    });
+                }
+
+                // - backward pass, constraints never moving an event after the terminal time
+                __latest.assign(_event_count, __terminal_time);
+                for (auto it = _order.crbegin(); it != _order.crend(); ++it)
+                {
+                    bool _first = true;
+                    for_each_out(*it, [&](index a)
+                    {
+                        const duration _start = __latest[completion_of(a)] - duration_of(a);
+                        __latest[*it] = _first ? _start : std::min(__latest[*it], _start);
+                        if (is_link(a))
+                            __latest[*it] = std::min(__latest[*it], __terminal_time);
+                        _first = false;
+                    });
+                }
+            };
+
+            /// @brief Number of edges: those of the base (activities then links, deleted or not), then the added activities
+            index edge_count() const { return __durations.size() + __added.size(); }
+
+            /// @brief Check whether an edge is a precedence constraint link of the base
+            bool is_link(index a) const { return a < __durations.size() and __base->compiled().is_link(a); }
+
+            index trigger_of(index a) const { return a < __durations.size() ? __base->compiled().triggers[a] : __added_triggers[a - __durations.size()]; }
+            index completion_of(index a) const { return a < __durations.size() ? __base->compiled().completions[a] : __added_completions[a - __durations.size()]; }
+            duration duration_of(index a) const { return a < __durations.size() ? __durations[a] : __added_durations[a - __durations.size()]; }
+            activity activity_of(index a) const { return a < __durations.size() ? __base->compiled().activities[a] : __added[a - __durations.size()]; }
+
+            /// @brief Segment of an edge: an activity, or a link between its events with its lag as duration
+            segment segment_of(index a) const
+            {
+                if (not is_link(a))
+                    return segment(activity_of(a), duration_of(a));
+                const adjacency& _adjacency = __base->compiled();
+                return segment(activity(_adjacency.events[trigger_of(a)], _adjacency.events[completion_of(a)]), duration_of(a));
+            };
+
+            /// @brief Call a function on the edges completed by an event: base ones first, in compiled() order
+            template<typename Function>
+            void for_each_in(index an_event, const Function& a_function) const
+            {
+                const adjacency& _adjacency = __base->compiled();
+                if (an_event < _adjacency.event_count())
+                    for (const index* a = _adjacency.in_begin(an_event); a != _adjacency.in_end(an_event); ++a)
+                        if (not __deleted[*a])
+                            a_function(*a);
+                for (index k = __added_in_offsets[an_event]; k != __added_in_offsets[an_event + 1]; ++k)
+                    a_function(__durations.size() + __added_in[k]);
+            };
+
+            /// @brief Call a function on the edges triggered by an event: base ones first, in compiled() order
+            template<typename Function>
+            void for_each_out(index an_event, const Function& a_function) const
+            {
+                const adjacency& _adjacency = __base->compiled();
+                if (an_event < _adjacency.event_count())
+                    for (index k = _adjacency.out_edge_begin(an_event); k != _adjacency.out_edge_end(an_event); ++k)
+                        if (not __deleted[_adjacency.out_edge(k)])
+                            a_function(_adjacency.out_edge(k));
+                for (index k = __added_out_offsets[an_event]; k != __added_out_offsets[an_event + 1]; ++k)
+                    a_function(__durations.size() + __added_out[k]);
+            };
+
+            /// @brief Get the index of an event, npos if the scenario does not know it
+            index event_index(const event& an_event) const
+            {
+                const adjacency& _adjacency = __base->compiled();
+                const index e = _adjacency.event_index(an_event);
+                if (e != adjacency::npos)
+                    return e;
+                auto search = std::lower_bound(__events.cbegin(), __events.cend(), an_event);
+                if (search == __events.cend() or an_event < *search)
+                    return adjacency::npos;
+                return _adjacency.event_count() + (search - __events.cbegin());
+            };
+
+            index checked_index(const event& an_event) const
+            {
+                const index e = event_index(an_event);
+                if (e == adjacency::npos)
+                    throw std::out_of_range("event is not in the network");
+                return e;
+            };
+
+            index checked_activity(const activity& an_activity) const
+            {
+                const index a = __base->compiled().activity_index(an_activity);
+                if (a != adjacency::npos and not __deleted[a])
+                    return a;
+                auto search = std::lower_bound(__added.cbegin(), __added.cend(), an_activity);
+                if (search == __added.cend() or not (*search == an_activity))
+                    throw std::out_of_range("activity is not in the network");
+                return __durations.size() + (search - __added.cbegin());
+            };
+
+        // data members
+        private:
+            std::shared_ptr<const network_type> __base;
+            duration __initial_time;
+            duration __terminal_time;
+            std::vector<duration> __durations;          ///< base edge index -> duration (lag of a link) in the scenario
+            std::vector<bool> __deleted;                ///< base edge index -> deleted by the scenario
+            std::vector<event> __events;                ///< events only used by added activities (sorted)
+            std::vector<activity> __added;              ///< added activities (sorted)
+            std::vector<duration> __added_durations;
+            std::vector<index> __added_triggers;
+            std::vector<index> __added_completions;
+            std::vector<index> __added_in_offsets;      ///< event index -> first slot in __added_in
+            std::vector<index> __added_in;              ///< added activities grouped by completion event
+            std::vector<index> __added_out_offsets;     ///< event index -> first slot in __added_out
+            std::vector<index> __added_out;             ///< added activities grouped by trigger event
+            std::vector<index> __terminal;              ///< events without outgoing activity or link in the scenario
+            std::vector<duration> __earliest;
+            std::vector<duration> __latest;
+        };
+
+    public:
+
+        /// @brief Share a network as the base of scenarios: its snapshot and times are built before it is shared
+        /// @param a_network network, moved into the shared base
+        /// @return the immutable base
+        static std::shared_ptr<const network_type> share(network_type a_network)
+        {
+            auto _base = std::make_shared<const network_type>(std::move(a_network));
+            _base->compiled();
+            _base->times();
+            return _base;
+        };
+
+        /// @brief Start a scenario without edits
+        /// @param a_base immutable base network, compiled before it is shared (see share)
+        explicit scenario(std::shared_ptr<const network_type> a_base) : __base(std::move(a_base)) {};
+
+        /// @brief Get the base network
+        const network_type& base() const
+        {
+            return *__base;
+        };
+
+        /// @brief Get the number of edits stored by the scenario
+        std::size_t edit_count() const
+        {
+            return __durations.size() + __deleted.size() + __added.size() + (__schedule ? 1 : 0);
+        };
+
+        /// @brief Check whether an activity is in the scenario
+        bool contains(const activity& an_activity) const
+        {
+            const index a = __base->compiled().activity_index(an_activity);
+            return a != adjacency::npos ? __deleted.count(a) == 0 : __added.count(an_activity) > 0;
+        };
+
+        /// @brief Get the duration of an activity in the scenario
+        /// @throw std::out_of_range if the activity is not in the scenario
+        duration estimated_duration(const activity& an_activity) const
+        {
+            const index a = __base->compiled().activity_index(an_activity);
+            if (a != adjacency::npos and __deleted.count(a) == 0)
+            {
+                auto search = __durations.find(a);
+                return search != __durations.end() ? search->second : __base->compiled().durations[a];
+            }
+            auto search = __added.find(an_activity);
+            if (search == __added.end())
+                throw std::out_of_range("activity is not in the network");
+            return search->second;
+        };
+
+        /// @brief Set the duration of an activity in the scenario, adding the activity if it is not in the scenario
+        /// @return a reference to this scenario (for syntactic sugar)
+        scenario& set_estimated_duration(const activity& an_activity, const duration& a_duration)
+        {
+            const index a = __base->compiled().activity_index(an_activity);
+            if (a == adjacency::npos)
+            {
+                __added.insert_or_assign(an_activity, a_duration);
+                return *this;
+            }
+            __deleted.erase(a);
+            if (a_duration == __base->compiled().durations[a])
+                __durations.erase(a);
+            else
+                __durations.insert_or_assign(a, a_duration);
+            return *this;
+        };
+
+        /// @brief Add an activity to the scenario, or set its duration if it is already there
+        /// @return a reference to this scenario (for syntactic sugar)
+        scenario& add_activity(const activity& an_activity, const duration& a_duration)
+        {
+            return set_estimated_duration(an_activity, a_duration);
+        };
+
+        /// @brief Delete an activity from the scenario
+        /// @return a reference to this scenario (for syntactic sugar)
+        scenario& delete_activity(const activity& an_activity)
+        {
+            const index a = __base->compiled().activity_index(an_activity);
+            if (a == adjacency::npos)
+            {
+                __added.erase(an_activity);
+                return *this;
+            }
+            __durations.erase(a);
+            __deleted.insert(a);
+            return *this;
+        };
+
+        /// @brief Set the scenario's initial and terminal times
+        /// @return a reference to this scenario (for syntactic sugar)
+        scenario& schedule(const duration& an_initial_time, const duration& a_terminal_time)
+        {
+            __schedule.emplace(an_initial_time, a_terminal_time);
+            return *this;
+        };
+
+        /// @brief Get the scenario's initial time
+        duration initial_time() const
+        {
+            return __schedule ? __schedule->first : __base->initial_time();
+        };
+
+        /// @brief Get the scenario's terminal time
+        duration terminal_time() const
+        {
+            return __schedule ? __schedule->second : __base->terminal_time();
+        };
+
+        /// @brief Compute the event times of the scenario
+        /// @throw std::logic_error if the scenario contains a loop
+        analysis analyse() const
+        {
+            return analysis(*this);
+        };
+
+        /// @brief Build a standalone network: a copy of the base with the scenario's edits applied
+        network_type materialize() const
+        {
+            network_type _network(*__base);
+            for (const index a: __deleted)
+                _network.delete_activity(__base->compiled().activities[a]);
+            for (const auto& [a, d]: __durations)
+                _network.set_estimated_duration(__base->compiled().activities[a], d);
+            for (const auto& [a, d]: __added)
+                _network.add_activity(a, d);
+            _network.schedule(initial_time(), terminal_time());
+            return _network;
+        };
+
+    // data members
+    private:
+        std::shared_ptr<const network_type> __base;
+        std::unordered_map<index, duration> __durations;        ///< base activity index -> changed duration
+        std::unordered_set<index> __deleted;                    ///< deleted base activity indices
+        std::map<activity, duration> __added;                   ///< activities which are not in the base
+        std::optional<std::pair<duration, duration>> __schedule;
+
+    };
+
+} // namespace pert
@@ -0,0 +1,522 @@
+/***
+ * @brief This file describes a query server answering pipelined network commands with JSON lines.
+ * @author Johann Fotsing
+ * @date 2026-10-16
+ * @file pert_server.h
+ */
+
+#pragma once
+
+#include <pert.h>
+#include <pert_io.h>
+#include <cerrno>
+#include <cstring>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace pert
+{
+
+    /**
+     * @brief This class serves queries on a network loaded once, its schedule cached up front.
+     * A request is a line "command argument...", as read by the interactive command line (earliest_occurence_of 4,
+     * critical_path, paths 1 9, ...). Each request is answered by one JSON line, in request order:
+     * {"command": "...", "result": ...} or {"command": "...", "error": "..."}.
+     * Requests are read in chunks and every complete request of a chunk is answered before the answers are written at
+     * once, so clients can pipeline batches of requests without waiting for each answer.
+     * Paths are given as arrays of [trigger, completion, duration] segments.
+     *
+     * @tparam EventIDType type of the network's event objects
+     * @tparam DurationType type of the network's duration objects
+     */
+    template<typename EventIDType, typename DurationType>
+    class server
+    {
+
+    public:
+
+        /// @brief context types
+        using network_type = network<EventIDType, DurationType>;
+        using event = EventIDType;
+        using duration = DurationType;
+        using activity = typename network_type::activity;
+        using path = typename network_type::path;
+
+        /// @brief Take the network to serve and cache its snapshot and, without loop, its schedule
+        /// @param a_network network
+        explicit server(network_type a_network) : __network(std::move(a_network))
+        {
+            if (__network.compiled().acyclic())
+                __network.times();
+        };
+
+        /// @brief Get the served network
+        const network_type& served() const
+        {
+            return __network;
+        };
+
+        /// @brief Answer one request
+        /// @param a_request request line, without its end of line
+        /// @param a_response buffer to which the JSON answer line is appended (nothing for blank lines and q)
+        /// @return false if the request ends the session (q, quit or shutdown)
+        bool handle(std::string_view a_request, std::string& a_response)
+        {
+            __arguments.clear();
+            for (std::size_t i = 0; i < a_request.size(); )
+            {
+                while (i < a_request.size() and (a_request[i] == ' ' or a_request[i] == '\t' or a_request[i] == '\r'))
+                    ++i;
+                const std::size_t _begin = i;
+                while (i < a_request.size() and a_request[i] != ' ' and a_request[i] != '\t' and a_request[i] != '\r')
+                    ++i;
+                if (i > _begin)
+                    __arguments.push_back(a_request.substr(_begin, i - _begin));
+            }
+            if (__arguments.empty())
+                return true;
+            const std::string_view _command = __arguments.front();
+            if (_command == "q" or _command == "quit")
+                return false;
+            if (_command == "shutdown")
+            {
+                __shutdown = true;
+                return false;
+            }
+
+            a_response += "{\"command\": ";
+            append_json_string(a_response, _command);
+            auto search = commands().find(_command);
+            try
+            {
+                if (search == commands().end())
+                    throw std::invalid_argument("unknown command");
+                if (__arguments.size() != search->second.arguments + 1)
+                    throw std::invalid_argument("expected " + std::to_string(search->second.arguments) + " argument(s)");
+                const std::size_t _result = a_response.size();
+                try
+                {
+                    a_response += ", \"result\": ";
+                    (this->*search->second.answer)(a_response);
+                }
+                catch (...)
+                {
+                    a_response.resize(_result);
+                    throw;
+                }
+            }
+            catch (const std::exception& e)
+            {
+                a_response += ", \"error\": ";
+                append_json_string(a_response, e.what());
+            }
+            a_response += "}\n";
+            ++__served;
+            return true;
+        };
+
+        /// @brief Serve requests from a file descriptor until its end or a request ending the session
+        /// @param an_input descriptor the requests are read from
+        /// @param an_output descriptor the answers are written to
+        /// @return number of requests answered
+        /// @throw std::runtime_error if a descriptor cannot be read or written
+        std::size_t serve(int an_input, int an_output)
+        {
+            const std::size_t _served = __served;
+            std::string _requests, _responses;
+            char _chunk[1 << 16];
+            bool _open = true;
+            while (_open)
+            {
+                const ssize_t _read = ::read(an_input, _chunk, sizeof(_chunk));
+                if (_read < 0 and errno == EINTR)
+                    continue;
+                if (_read < 0)
+                    throw std::runtime_error(std::string("cannot read requests: ") + std::strerror(errno));
+                if (_read == 0)
+                {
+                    // a last request without end of line
+                    if (not _requests.empty())
+                        handle(_requests, _responses);
+                    _requests.clear();
+                    _open = false;
+                }
+                else
+                {
+                    _requests.append(_chunk, static_cast<std::size_t>(_read));
+                    std::size_t _begin = 0;
+                    for (std::size_t _end = _requests.find('\n'); _open and _end != std::string::npos; _end = _requests.find('\n', _begin))
+                    {
+                        _open = handle(std::string_view(_requests).substr(_begin, _end - _begin), _responses);
+                        _begin = _end + 1;
+                    }
+                    _requests.erase(0, _begin);
+                }
+                write_all(an_output, _responses);
+                _responses.clear();
+            }
+            return __served - _served;
+        };
+
+        /// @brief Serve the connections of a Unix domain socket, one after the other, until a shutdown request
+        /// @param a_path path of the socket, replaced if it exists and removed when the server stops
+        /// @throw std::runtime_error if the socket cannot be created
+        void serve_socket(const std::string& a_path)
+        {
+            sockaddr_un _address {};
+            _address.sun_family = AF_UNIX;
+            if (a_path.size() >= sizeof(_address.sun_path))
+                throw std::runtime_error("socket path is too long: " + a_path);
+            std::memcpy(_address.sun_path, a_path.c_str(), a_path.size() + 1);
+
+            const int _socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+            if (_socket < 0)
+                throw std::runtime_error(std::string("cannot create socket: ") + std::strerror(errno));
+            ::unlink(a_path.c_str());
+            if (::bind(_socket, reinterpret_cast<const sockaddr*>(&_address), sizeof(_address)) != 0 or ::listen(_socket, 16) != 0)
+            {
+                const std::string _error = std::strerror(errno);
+                ::close(_socket);
+                throw std::runtime_error("cannot listen on " + a_path + ": " + _error);
+            }
+            __shutdown = false;
+            while (not __shutdown)
+            {
+                const int _connection = ::accept(_socket, nullptr, nullptr);
+                if (_connection < 0)
+                {
+                    if (errno == EINTR or errno == ECONNABORTED)
+                        continue;
+                    const std::string _error = std::strerror(errno);
+                    ::close(_socket);
+                    ::unlink(a_path.c_str());
+                    throw std::runtime_error("cannot accept a connection: " + _error);
+                }
+                try
+                {
+                    serve(_connection, _connection);
+                }
+                catch (const std::runtime_error&)
+                {
+                    // a client leaving early only ends its own connection
+                }
+                ::close(_connection);
+            }
+            ::close(_socket);
+            ::unlink(a_path.c_str());
+        };
+
+        /// @brief Get the number of requests answered since the server started
+        std::size_t served_requests() const
+        {
+            return __served;
+        };
+
+    private:
+
+        /// @brief Command of the table: number of arguments and member answering it
+        struct command
+        {
+            std::size_t arguments;
+            void (server::*answer)(std::string&);
+        };
+
+        /// @brief Get the command table
+        static const std::unordered_map<std::string_view, command>& commands()
+        {
+            static const std::unordered_map<std::string_view, command> _commands {
+                { "network", { 0, &server::answer_network } },
+                { "earliest_occurence_of", { 1, &server::answer_earliest_occurence } },
+                { "latest_occurence_of", { 1, &server::answer_latest_occurence } },
+                { "earliest_finish_of", { 2, &server::answer_earliest_finish } },
+                { "latest_start_of", { 2, &server::answer_latest_start } },
+                { "activity_float_of", { 2, &server::answer_activity_float } },
+                { "free_float_of", { 2, &server::answer_free_float } },
+                { "interfering_float_of", { 2, &server::answer_interfering_float } },
+                { "independent_float_of", { 2, &server::answer_independent_float } },
+                { "floats", { 0, &server::answer_floats } },
+                { "sensitivity", { 0, &server::answer_sensitivity } },
+                { "critical_path", { 0, &server::answer_critical_path } },
+                { "critical_paths", { 0, &server::answer_critical_paths } },
+                { "paths", { 2, &server::answer_paths } },
+                { "count_paths", { 2, &server::answer_count_paths } },
+                { "subnet", { 2, &server::answer_subnet } },
+                { "stats", { 0, &server::answer_stats } },
+                { "stats_reset", { 0, &server::answer_stats_reset } }
+            };
+            return _commands;
+        };
+
+        // - commands
+
+        void answer_network(std::string& a_response)
+        {
+            append_network(a_response, __network);
+        };
+
+        void answer_earliest_occurence(std::string& a_response)
+        {
+            append_json(a_response, __network.earliest_occurence(event_argument(1)));
+        };
+
+        void answer_latest_occurence(std::string& a_response)
+        {
+            append_json(a_response, __network.latest_occurence(event_argument(1)));
+        };
+
+        void answer_earliest_finish(std::string& a_response)
+        {
+            append_json(a_response, __network.earliest_finish(activity_argument()));
+        };
+
+        void answer_latest_start(std::string& a_response)
+        {
+            append_json(a_response, __network.latest_start(activity_argument()));
+        };
+
+        void answer_activity_float(std::string& a_response)
+        {
+            append_json(a_response, __network.activity_float(activity_argument()));
+        };
+
+        void answer_free_float(std::string& a_response)
+        {
+            append_json(a_response, __network.free_float(activity_argument()));
+        };
+
+        void answer_interfering_float(std::string& a_response)
+        {
+            append_json(a_response, __network.interfering_float(activity_argument()));
+        };
+
+        void answer_independent_float(std::string& a_response)
+        {
+            append_json(a_response, __network.independent_float(activity_argument()));
+        };
+
+        void answer_floats(std::string& a_response)
+        {
+            const auto& _adjacency = __network.compiled();
+            const auto _report = __network.floats();
+            a_response += '[';
+            for (std::size_t a = 0; a < _adjacency.activity_count(); ++a)
+            {
+                a_response += a > 0 ? ", {\"trigger\": " : "{\"trigger\": ";
+                append_json(a_response, _adjacency.activities[a].trigger_event());
+                a_response += ", \"completion\": ";
+                append_json(a_response, _adjacency.activities[a].completion_event());
+                const std::pair<const char*, duration> _fields[] = {
+                    { ", \"duration\": ", _adjacency.durations[a] }, { ", \"earliest_start\": ", _report.earliest_start[a] },
+                    { ", \"earliest_finish\": ", _report.earliest_finish[a] }, { ", \"latest_start\": ", _report.latest_start[a] },
+                    { ", \"latest_finish\": ", _report.latest_finish[a] }, { ", \"activity_float\": ", _report.activity_float[a] },
+                    { ", \"free_float\": ", _report.free_float[a] }, { ", \"interfering_float\": ", _report.interfering_float[a] },
+                    { ", \"independent_float\": ", _report.independent_float[a] } };
+                for (const auto& [_name, _value]: _fields)
+                {
+                    a_response += _name;
+                    append_json(a_response, _value);
+                }
+                a_response += '}';
+            }
+            a_response += ']';
+        };
+
+        void answer_sensitivity(std::string& a_response)
+        {
+            const auto& _adjacency = __network.compiled();
+            const auto _report = __network.sensitivity();
+            a_response += "{\"completion\": ";
+            append_json(a_response, _report.completion);
+            a_response += ", \"activities\": [";
+            for (std::size_t a = 0; a < _adjacency.activity_count(); ++a)
+            {
+                a_response += a > 0 ? ", {\"trigger\": " : "{\"trigger\": ";
+                append_json(a_response, _adjacency.activities[a].trigger_event());
+                a_response += ", \"completion\": ";
+                append_json(a_response, _adjacency.activities[a].completion_event());
+                const std::pair<const char*, duration> _fields[] = {
+                    { ", \"duration\": ", _adjacency.durations[a] }, { ", \"total_float\": ", _report.total_float[a] },
+                    { ", \"lower\": ", _report.lower[a] }, { ", \"upper\": ", _report.upper[a] }, { ", \"relief\": ", _report.relief[a] } };
+                for (const auto& [_name, _value]: _fields)
+                {
+                    a_response += _name;
+                    append_json(a_response, _value);
+                }
+                a_response += '}';
+            }
+            a_response += "]}";
+        };
+
+        void answer_critical_path(std::string& a_response)
+        {
+            append_path(a_response, __network.find_critical_path());
+        };
+
+        void answer_critical_paths(std::string& a_response)
+        {
+            a_response += '[';
+            bool _first = true;
+            for (const path& p: __network.critical_paths())
+            {
+                a_response += _first ? "" : ", ";
+                append_path(a_response, p);
+                _first = false;
+            }
+            a_response += ']';
+        };
+
+        void answer_paths(std::string& a_response)
+        {
+            const event _start = event_argument(1), _finish = event_argument(2);
+            a_response += '[';
+            bool _first = true;
+            for (const path& p: __network.enumerate_paths(_start, _finish))
+            {
+                a_response += _first ? "" : ", ";
+                append_path(a_response, p);
+                _first = false;
+            }
+            a_response += ']';
+        };
+
+        void answer_count_paths(std::string& a_response)
+        {
+            const auto _summary = __network.summarize_paths(event_argument(1), event_argument(2));
+            a_response += "{\"count\": ";
+            append_json(a_response, _summary.count);
+            a_response += ", \"shortest\": ";
+            append_json(a_response, _summary.shortest);
+            a_response += ", \"longest\": ";
+            append_json(a_response, _summary.longest);
+            a_response += '}';
+        };
+
+        void answer_subnet(std::string& a_response)
+        {
+            append_network(a_response, __network.subnet(event_argument(1), event_argument(2)));
+        };
+
+        void answer_stats(std::string& a_response)
+        {
+            a_response += stats().to_json();
+        };
+
+        void answer_stats_reset(std::string& a_response)
+        {
+            stats().reset();
+            a_response += "null";
+        };
+
+        // - arguments and answers
+
+        /// @brief Parse an argument of the current request as an event
+        /// @throw std::invalid_argument if the argument does not exactly hold an event
+        event event_argument(std::size_t an_argument) const
+        {
+            const std::string_view _token = __arguments[an_argument];
+            event _event {};
+            if (not parse_token(_token, _event))
+                throw std::invalid_argument("invalid event " + std::string(_token));
+            return _event;
+        };
+
+        /// @brief Parse the two arguments of the current request as an activity of the network
+        /// @throw std::out_of_range if the activity is not in the network
+        activity activity_argument() const
+        {
+            const activity _activity(event_argument(1), event_argument(2));
+            if (__network.compiled().activity_index(_activity) == network_type::adjacency::npos)
+                throw std::out_of_range("activity is not in the network");
+            return _activity;
+        };
+
+        /// @brief Append a path as an array of [trigger, completion, duration] segments
+        static void append_path(std::string& a_response, const path& a_path)
+        {
+            a_response += '[';
+            for (std::size_t s = 0; s < a_path.size(); ++s)
+            {
+                a_response += s > 0 ? ", [" : "[";
+                append_json(a_response, a_path[s].first.trigger_event());
+                a_response += ", ";
+                append_json(a_response, a_path[s].first.completion_event());
+                a_response += ", ";
+                append_json(a_response, a_path[s].second);
+                a_response += ']';
+            }
+            a_response += ']';
+        };
+
+        /// @brief Append the ends and the activities of a network or of a subnet view
+        template<typename NetworkView>
+        static void append_network(std::string& a_response, const NetworkView& a_network)
+        {
+            const auto append_events = [&a_response](const std::set<event>& some_events)
+            {
+                a_response += '[';
+                for (auto it = some_events.cbegin(); it != some_events.cend(); ++it)
+                {
+                    a_response += it != some_events.cbegin() ? ", " : "";
+                    append_json(a_response, *it);
+                }
+                a_response += ']';
+            };
+            a_response += "{\"initial_events\": ";
+            append_events(a_network.initial_events());
+            a_response += ", \"terminal_events\": ";
+            append_events(a_network.terminal_events());
+            a_response += ", \"well_formed\": ";
+            a_response += a_network.is_well_formed() ? "true" : "false";
+            a_response += ", \"initial_time\": ";
+            append_json(a_response, a_network.initial_time());
+            a_response += ", \"terminal_time\": ";
+            append_json(a_response, a_network.terminal_time());
+            a_response += ", \"activities\": [";
+            bool _first = true;
+            for (const activity& a: a_network.activities())
+            {
+                a_response += _first ? "[" : ", [";
+                append_json(a_response, a.trigger_event());
+                a_response += ", ";
+                append_json(a_response, a.completion_event());
+                a_response += ", ";
+                append_json(a_response, a_network.estimated_duration(a));
+                a_response += ']';
+                _first = false;
+            }
+            a_response += "]}";
+        };
+
+        /// @brief Write a whole buffer to a file descriptor; a socket closed by its client raises an error, not SIGPIPE
+        static void write_all(int an_output, const std::string& a_buffer)
+        {
+            for (std::size_t _written = 0; _written < a_buffer.size(); )
+            {
+                ssize_t _count = ::send(an_output, a_buffer.data() + _written, a_buffer.size() - _written, MSG_NOSIGNAL);
+                if (_count < 0 and errno == ENOTSOCK)
+                    _count = ::write(an_output, a_buffer.data() + _written, a_buffer.size() - _written);
+                if (_count < 0 and errno == EINTR)
+                    continue;
+                if (_count < 0)
+                    throw std::runtime_error(std::string("cannot write answers: ") + std::strerror(errno));
+                _written += static_cast<std::size_t>(_count);
+            }
+        };
+
+    // data members
+    private:
+        network_type __network;
+        std::vector<std::string_view> __arguments;  ///< tokens of the current request
+        std::size_t __served = 0;
+        bool __shutdown = false;
+
+    };
+
+} // namespace pert
@@ -0,0 +1,210 @@
+/***
+ * @brief This file describes a work-stealing thread pool running the library's concurrent analyses.
+ * @author Johann Fotsing
+ * @date 2026-10-16
+ * @file pert_thread_pool.h
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pert
+{
+
+    /**
+     * @brief This class runs tasks on a fixed set of worker threads.
+     * Each worker owns a task deque: tasks submitted by a worker go to the back of its own deque and are run
+     * last in first out, tasks submitted from other threads are dealt to the workers in turn, and a worker
+     * without task steals the oldest task of another worker. The result (or exception) of a task is delivered
+     * through a future.
+     *
+     */
+    class thread_pool
+    {
+
+    public:
+
+        /// @brief Start the worker threads
+        /// @param a_thread_count number of workers, 0 uses every hardware thread
+        explicit thread_pool(unsigned a_thread_count = 0)
+        {
+            const unsigned _count = a_thread_count > 0 ? a_thread_count : std::max(1u, std::thread::hardware_concurrency());
+            for (unsigned t = 0; t < _count; ++t)
+                __queues.push_back(std::make_unique<queue>());
+            __workers.reserve(_count);
+            for (unsigned t = 0; t < _count; ++t)
+                __workers.emplace_back([this, t]() { work(t); });
+        };
+
+        thread_pool(const thread_pool&) = delete;
+        thread_pool& operator=(const thread_pool&) = delete;
+
+        /// @brief Run the queued tasks, then stop the worker threads
+        ~thread_pool()
+        {
+            {
+                std::lock_guard<std::mutex> _lock(__mutex);
+                __stopping = true;
+            }
+            __wake.notify_all();
+            for (auto& w: __workers)
+                w.join();
+        };
+
+        /// @brief Get the number of worker threads
+        unsigned size() const
+        {
+            return static_cast<unsigned>(__workers.size());
+        };
+
+        /// @brief Queue a task
+        /// @param a_task callable without argument
+        /// @return the future result of the task
+        template<typename Task>
+        auto submit(Task&& a_task) -> std::future<decltype(a_task())>
+        {
+            using result = decltype(a_task());
+            auto _task = std::make_shared<std::packaged_task<result()>>(std::forward<Task>(a_task));
+            std::future<result> _future = _task->get_future();
+            const std::size_t _queue = __owner == this ? __self : __next_queue++ % __queues.size();
+            {
+                std::lock_guard<std::mutex> _lock(__mutex);
+                ++__pending;
+            }
+            {
+                std::lock_guard<std::mutex> _lock(__queues[_queue]->mutex);
+                __queues[_queue]->tasks.emplace_back([_task]() { (*_task)(); });
+            }
+            __wake.notify_one();
+            return _future;
+        };
+
+        /// @brief Wait for a future; a worker of the pool runs other tasks meanwhile instead of blocking
+        /// @param a_future future of a task of the pool
+        template<typename Result>
+        void wait(std::future<Result>& a_future)
+        {
+            if (__owner == this)
+            {
+                while (a_future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                    if (not run_one(__self))
+                        std::this_thread::yield();
+            }
+            a_future.wait();
+        };
+
+        /// @brief Call a function on every index of a range, spread over the workers, and wait for the calls to end
+        /// @param a_count number of indices, the range is [0, a_count)
+        /// @param a_function callable taking an index; the first exception it throws is rethrown here
+        template<typename Function>
+        void parallel_for(std::size_t a_count, const Function& a_function)
+        {
+            // workers take the next index until the range is exhausted, so that uneven calls balance out
+            std::atomic<std::size_t> _next(0);
+            const std::size_t _task_count = std::min<std::size_t>(a_count, size());
+            std::vector<std::future<void>> _futures;
+            _futures.reserve(_task_count);
+            for (std::size_t t = 0; t < _task_count; ++t)
+                _futures.push_back(submit([&_next, a_count, &a_function]()
+                {
+                    for (std::size_t i = _next++; i < a_count; i = _next++)
+                        a_function(i);
+                }));
+            for (auto& f: _futures)
+                wait(f);
+            for (auto& f: _futures)
+                f.get();
+        };
+
+    private:
+
+        /// @brief Task deque of a worker
+        struct queue
+        {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        /// @brief Take a task: the newest one of a worker's own deque, or else the oldest one of another deque
+        /// @param a_worker worker number
+        /// @param a_task the task taken
+        /// @return true if a task was taken
+        bool take(std::size_t a_worker, std::function<void()>& a_task)
+        {
+            for (std::size_t k = 0; k < __queues.size(); ++k)
+            {
+                queue& _queue = *__queues[(a_worker + k) % __queues.size()];
+                std::lock_guard<std::mutex> _lock(_queue.mutex);
+                if (_queue.tasks.empty())
+                    continue;
+                if (k == 0)
+                {
+                    a_task = std::move(_queue.tasks.back());
+                    _queue.tasks.pop_back();
+                }
+                else
+                {
+                    a_task = std::move(_queue.tasks.front());
+                    _queue.tasks.pop_front();
+                }
+                std::lock_guard<std::mutex> _pending(__mutex);
+                --__pending;
+                return true;
+            }
+            return false;
+        };
+
+        /// @brief Run one task if any is queued
+        bool run_one(std::size_t a_worker)
+        {
+            std::function<void()> _task;
+            if (not take(a_worker, _task))
+                return false;
+            _task();
+            return true;
+        };
+
+        /// @brief Worker loop: run queued tasks until the pool stops and every queue is empty
+        void work(std::size_t a_worker)
+        {
+            __owner = this;
+            __self = a_worker;
+            while (true)
+            {
+                if (run_one(a_worker))
+                    continue;
+                std::unique_lock<std::mutex> _lock(__mutex);
+                __wake.wait(_lock, [this]() { return __stopping or __pending > 0; });
+                if (__stopping and __pending == 0)
+                    return;
+            }
+        };
+
+    // data members
+    private:
+        std::vector<std::unique_ptr<queue>> __queues;
+        std::vector<std::thread> __workers;
+        std::atomic<std::size_t> __next_queue { 0 };
+        std::mutex __mutex;
+        std::condition_variable __wake;
+        std::size_t __pending = 0;          ///< queued tasks, guarded by __mutex
+        bool __stopping = false;
+
+        /// @brief Pool and worker number of the calling thread, if it is a worker
+        static inline thread_local const thread_pool* __owner = nullptr;
+        static inline thread_local std::size_t __self = 0;
+
+    };
+
+} // namespace pert
@@ -7,6 +7,9 @@
 
 #include <iostream>
 #include <pert.h>
+#include <pert_io.h>
+#include <pert_portfolio.h>
+#include <pert_server.h>
 #include <fstream>
 #include <sstream>
 #include <streambuf>
@@ -22,4 +25,6 @@ using Network = network<int, int>;
 int test_basic(const Network&);
 int test_from_dummy();
 int test_from_txt(const char*);
-int test_interactive(const char*);
\ No newline at end of file
+int test_interactive(const char*);
+int test_batch(int, char**);
+int test_serve(int, char**);
\ No newline at end of file
@@ -13,9 +13,76 @@
 
 int main(int argc, char** argv)
 {
+    // pert_cpm network_file, pert_cpm --batch [--threads n] network_file|@list_file...,
+    // or pert_cpm --serve network_file | --socket socket_path network_file
+    if (argc > 1 and std::string(argv[1]) == "--batch")
+        return test_batch(argc - 2, argv + 2);
+    if (argc > 1 and (std::string(argv[1]) == "--serve" or std::string(argv[1]) == "--socket"))
+        return test_serve(argc - 1, argv + 1);
     return test_interactive(argv[1]);
 }
 
+int test_serve(int argc, char** argv)
+{
+    const bool on_socket = std::string(argv[0]) == "--socket";
+    if (argc != (on_socket ? 3 : 2))
+    {
+        std::cerr << "(*) Usage: pert_cpm --serve network_file | --socket socket_path network_file" << std::endl;
+        return 1;
+    }
+    try
+    {
+        server<int, int> query_server(load_txt<int, int>(argv[argc - 1]));
+        if (on_socket)
+            query_server.serve_socket(argv[1]);
+        else
+            query_server.serve(STDIN_FILENO, STDOUT_FILENO);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "(*) " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+int test_batch(int argc, char** argv)
+{
+    // network files, or files listing one network file per line when prefixed by @
+    unsigned threads = 0;
+    std::vector<std::string> files;
+    for (int i = 0; i < argc; ++i)
+    {
+        const std::string argument = argv[i];
+        if (argument == "--threads" and i + 1 < argc)
+            threads = static_cast<unsigned>(std::atoi(argv[++i]));
+        else if (argument.size() > 1 and argument[0] == '@')
+        {
+            std::ifstream list(argument.substr(1));
+            if (!list)
+            {
+                std::cerr << "(*) Cannot read network list " << argument.substr(1) << std::endl;
+                return 1;
+            }
+            for (std::string file; std::getline(list, file);)
+                if (!file.empty())
+                    files.push_back(file);
+        }
+        else
+            files.push_back(argument);
+    }
+
+    // one JSON line per network, as networks finish
+    int status = 0;
+    portfolio<int, int> evaluator(threads);
+    evaluator.evaluate_files(files, [&status](const portfolio<int, int>::report& r)
+    {
+        std::cout << r.to_json() << std::endl;
+        status |= r.ok ? 0 : 1;
+    });
+    return status;
+}
+
 int test_from_dummy()
 {
     Network test_network;
@@ -53,14 +120,12 @@ int test_from_dummy()
 int test_from_txt(const char* file_name)
 {
     // from txt network
-    std::ifstream input_file(file_name);
-    std::string file_str((std::istreambuf_iterator<char>(input_file)), std::istreambuf_iterator<char>());
-    input_file.close();
-    network test_network = Network::from_txt(file_str);
+    network test_network = load_txt<int, int>(file_name);
     return test_basic(test_network);
 }
 
-void show_network(const Network& a_network)
+template<typename NetworkView>
+void show_network(const NetworkView& a_network)
 {
     // Network display section
     std::cout << "\n* Network\n----------" << std::endl;
@@ -104,48 +169,38 @@ int test_basic(const Network& a_network)
 int test_interactive(const char* network_file)
 {
     // from txt network
-    std::ifstream input_file(network_file);
-    std::string file_str((std::istreambuf_iterator<char>(input_file)), std::istreambuf_iterator<char>());
-    input_file.close();
-    Network test_network = Network::from_txt(file_str);
+    Network test_network;
+    try
+    {
+        test_network = load_txt<int, int>(network_file);
+    }
+    catch (const std::exception& e)
+    {
+        std::cout << "(*) Cannot load network: " << e.what() << std::endl;
+        return 1;
+    }
 
     show_network(test_network);
 
-    if (!test_network.is_well_formed())
+    auto validation = test_network.validate();
+    if (!validation.well_formed())
     {
-        std::map<Network::event, std::vector<Network::path>> loops_map;
-        for (const auto& a: test_network.activities())
-        {
-            auto loop_paths = test_network.loop_paths(a.trigger_event(), a.trigger_event());
-            auto search = loops_map.find(a.trigger_event());
-            if (search != loops_map.end())
-            {
-                continue;
-            }
-            if (!loop_paths.empty())
-            {
-                loops_map.insert({a.trigger_event(), loop_paths});
-            }
-        }
-
-        if (!loops_map.empty())
+        if (!validation.loops.empty())
         {
             std::cout << "(*) Loops:\n----------" << std::endl;
         }
 
-        for (const auto& lm_entry: loops_map)
+        for (const auto& lp: validation.loops)
         {
+            const auto loop_event = lp.cbegin()->first.trigger_event();
             std::cout << std::endl;
-            std::cout << "(" << lm_entry.first << " *** " << lm_entry.first << ")" << ": " << std::endl;
-            for (const auto& lp: lm_entry.second)
+            std::cout << "(" << loop_event << " *** " << loop_event << ")" << ": " << std::endl;
+            std::cout << "  ";
+            for (const auto& s: lp)
             {
-                std::cout << "  ";
-                for (const auto& s: lp)
-                {
-                    std::cout << "[" << s.first.trigger_event() << "]" << " --=" << s.second << "=--> ";
-                }
-                std::cout << "[" << lp.rbegin()->first.completion_event() << "]" << std::endl;
+                std::cout << "[" << s.first.trigger_event() << "]" << " --=" << s.second << "=--> ";
             }
+            std::cout << "[" << lp.rbegin()->first.completion_event() << "]" << std::endl;
         }
         return 0;
     }
@@ -230,6 +285,26 @@ int test_interactive(const char* network_file)
             std::stringstream(pars) >> e_finish;
             std::cout << test_network.independent_float(Network::activity(e_start, e_finish)) << std::endl;
         }
+        else if(network_command == "floats")
+        {
+            write_floats(std::cout, test_network, '\t');
+        }
+        else if(network_command == "sensitivity")
+        {
+            try
+            {
+                write_sensitivity(std::cout, test_network, '\t');
+            }
+            catch (const std::invalid_argument& e)
+            {
+                std::cout << "(*) " << e.what() << std::endl;
+            }
+        }
+        else if(network_command == "links")
+        {
+            for (const auto& [l, lag]: test_network.links())
+                std::cout << l.trigger_event() << "...>" << l.completion_event() << "  : " << lag << std::endl;
+        }
         else if(network_command == "critical_path")
         {
             auto _path = test_network.find_critical_path();
@@ -237,7 +312,19 @@ int test_interactive(const char* network_file)
             {
                 std::cout << "[" << segment.first.trigger_event() << "] --=" << segment.second <<"=--> ";
             }
-            std::cout << "[" << _path.crbegin()->first.completion_event() << "]" << std::endl;
+            if (!_path.empty())
+                std::cout << "[" << _path.crbegin()->first.completion_event() << "]" << std::endl;
+        }
+        else if(network_command == "critical_paths")
+        {
+            for (const Network::path& p: test_network.critical_paths())
+            {
+                for (const Network::segment& s: p)
+                {
+                    std::cout << "[" << s.first.trigger_event() << "] --=" << s.second <<"=--> ";
+                }
+                std::cout << "[" << p.crbegin()->first.completion_event() << "]" << std::endl;
+            }
         }
         else if(network_command == "paths")
         {
@@ -246,8 +333,7 @@ int test_interactive(const char* network_file)
             std::stringstream(pars) >> e_start;
             std::cin >> pars;
             std::stringstream(pars) >> e_finish;
-            test_network.paths(e_start, e_finish);
-            for (const Network::path p: test_network.paths(e_start, e_finish))
+            for (const Network::path& p: test_network.enumerate_paths(e_start, e_finish))
             {
                 for (const Network::segment& s: p)
                 {
@@ -256,6 +342,18 @@ int test_interactive(const char* network_file)
                 std::cout << "[" << p.crbegin()->first.completion_event() << "]" << std::endl;
             }
         }
+        else if(network_command == "count_paths")
+        {
+            Network::event e_start, e_finish;
+            std::cin >> pars;
+            std::stringstream(pars) >> e_start;
+            std::cin >> pars;
+            std::stringstream(pars) >> e_finish;
+            const auto summary = test_network.summarize_paths(e_start, e_finish);
+            std::cout << "Paths: " << summary.count << std::endl;
+            std::cout << "Shortest: " << summary.shortest << std::endl;
+            std::cout << "Longest: " << summary.longest << std::endl;
+        }
         else if(network_command == "subnet")
         {
             Network::event e_start, e_finish;
@@ -263,7 +361,24 @@ int test_interactive(const char* network_file)
             std::stringstream(pars) >> e_start;
             std::cin >> pars;
             std::stringstream(pars) >> e_finish;
-            show_network(test_network.subnet(e_start, e_finish));
+            try
+            {
+                show_network(test_network.subnet(e_start, e_finish));
+            }
+            catch (const std::invalid_argument& e)
+            {
+                std::cout << "(*) " << e.what() << std::endl;
+            }
+        }
+        else if(network_command == "stats")
+        {
+            if (not pert::statistics::enabled())
+                std::cout << "Statistics are disabled: build with -DPERT_CPM_STATS=ON" << std::endl;
+            std::cout << pert::stats().to_json() << std::endl;
+        }
+        else if(network_command == "stats_reset")
+        {
+            pert::stats().reset();
         }
         std::cout << std::endl;
     }